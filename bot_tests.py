@@ -6,6 +6,8 @@ import itertools
 
 heuristics = ["basic", "a_basic", "board_aware"]
 depth_range = range(1, 9)
+# Parametry każdej gry, po nich podawana jest ścieżka logu gry.
+BASE_PARAMS = "--wbot true --bbot true --gui false --log"
 
 def run_games(executable):
     try:
@@ -24,7 +26,7 @@ def run_games(executable):
         else:
             executable = "./bin/pszt_warcaby"
     
-    base_params = " --wbot true --bbot true --gui false --log ./match_results/"
+    base_params = " " + BASE_PARAMS + " ./match_results/"
     
     games = get_test_games()
     
@@ -0,0 +1,101 @@
+/**
+ * @file Bench.hpp
+ * @author Bartosz Świrta
+ * @brief Zawiera deklarację klasy Bench - powtarzalnego pomiaru wydajności generatora ruchów
+ *        i przeszukiwania z porównaniem do zapisanego wyniku bazowego.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Config.hpp"
+
+namespace checkers
+{
+    /** \struct BenchResult
+     * @brief Wynik jednego pomiaru: perft albo przeszukiwania na stałą głębokość.
+     */
+    struct BenchResult
+    {
+        /// Nazwa pomiaru, po której wyniki są porównywane z bazowymi.
+        std::string name;
+        /// Rodzaj pomiaru: "perft" albo "search".
+        std::string kind;
+        /// Pozycja w zapisie GameState::to_string.
+        std::string position;
+        /// Heurystyka przeszukiwania (pusta dla perft).
+        std::string heuristic;
+        /// Głębokość perft lub przeszukiwania.
+        int depth = 0;
+        /// Liczba węzłów (liści perft lub węzłów przeszukiwania).
+        std::uint64_t nodes = 0;
+        /// Najkrótszy czas z powtórzeń pomiaru w milisekundach.
+        double timeMs = 0;
+        /// Wybrany ruch (pusty dla perft).
+        std::string move;
+        /// Najmniejsza z powtórzeń liczba alokacji na stercie (brak w plikach zapisanych bez niej).
+        std::optional<std::uint64_t> allocations = std::nullopt;
+        /// Liczba bajtów zaalokowanych w powtórzeniu z najmniejszą liczbą alokacji.
+        std::optional<std::uint64_t> bytes = std::nullopt;
+    };
+
+    /**
+     * @brief Mierzy wydajność na stałym zestawie pozycji i porównuje ją z wynikiem bazowym.
+     * @details Zestaw obejmuje perft (generator ruchów z Game.cpp) i przeszukiwania na stałą
+     *          głębokość każdą heurystyką (Search.cpp, BotMove.cpp), w jednym wątku i bez
+     *          ustawień z linii poleceń, więc liczba węzłów i wybrane ruchy są powtarzalne.
+     *          Każdy pomiar powtarzany jest config.benchRuns razy i liczy się najkrótszy czas;
+     *          przed każdym powtórzeniem przeszukiwania tablica ocen jest czyszczona.
+     *          Liczone są też alokacje na stercie (Memory.hpp) i największa zajęta pamięć procesu.
+     *          Wyniki zapisywane są do pliku JSON. Regresją jest inna liczba węzłów lub większa
+     *          liczba alokacji (poza tolerancją --benchnodetolerance), inny ruch niż w wyniku
+     *          bazowym oraz suma czasów dłuższa
+     *          od bazowej o więcej niż --benchtolerance procent. Wolniejsze pojedyncze pomiary
+     *          są tylko oznaczane.
+     */
+    class Bench
+    {
+    public:
+        /**
+         * @brief Konstruktor z podaną konfiguracją.
+         *
+         */
+        explicit Bench(const Config &config_);
+        /**
+         * @brief Wykonuje pomiary, zapisuje je do config.benchPath i porównuje z config.benchBaseline.
+         *
+         * @return Czy pomiar się udał i nie wykazał regresji.
+         */
+        bool run();
+        /**
+         * @brief Zapisuje wyniki do pliku JSON.
+         *
+         * @return Czy udało się zapisać plik.
+         */
+        static bool save(const std::string &path, const std::vector<BenchResult> &results);
+        /**
+         * @brief Wczytuje wyniki zapisane metodą save.
+         *
+         * @return std::optional<std::vector<BenchResult>> - wyniki lub nullopt jeśli pliku nie da się odczytać
+         */
+        static std::optional<std::vector<BenchResult>> try_load(const std::string &path);
+
+    private:
+        /// Konfiguracja programu.
+        Config config;
+
+        /// Wykonuje wszystkie pomiary zestawu.
+        std::vector<BenchResult> measure() const;
+        /// Porównuje wyniki z bazowymi i wypisuje różnice, zwraca czy nie ma regresji.
+        bool compare(const std::vector<BenchResult> &results, const std::vector<BenchResult> &baseline) const;
+    };
+
+} // namespace checkers
@@ -11,8 +11,11 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "Game.hpp"
 #include "Config.hpp"
+#include "Search.hpp"
 
 namespace checkers::bot
 {
@@ -20,15 +23,34 @@ namespace checkers::bot
     const int basicHeuristicTable[] = {4, 8, 4, 8};
     ///Tablica wag dla heurystyki BOARD_AWARE
     const int boardAwareHeuristicTable[] = {4, 8, 4, 8, 5, 6, 5, 6};
+    ///Największa premia pozycyjna heurystyki BOARD_AWARE, a zarazem największy zysk jednego cichego ruchu
+    const int boardAwarePositionalMax = std::max({boardAwareHeuristicTable[4], boardAwareHeuristicTable[5],
+                                                  boardAwareHeuristicTable[6], boardAwareHeuristicTable[7]});
 
     /**
      * @brief Zwraca ruch wykonywany przez bota za pomocą podanej taktyki.
-     * @param player - gracz dla którego będzie budowane drzewo
+     * @param gameState - stan gry, gracz wykonujący ruch jest graczem dla którego budowane jest drzewo
      * @param heuristicType - enumerator używanej heurystyki
      * @param depth - głębokość budowania drzewa gry
+     * @param features - włączone techniki przeszukiwania selektywnego
+     * @param progress - opcjonalna funkcja wywoływana co PROGRESS_INTERVAL z postępem przeszukiwania
+     * @param memory - źródło bloków obszaru pamięci przeszukiwania, zwalnianego przed powrotem z funkcji
      * @return std::pair<Coord, Coord> - współrzędne najlepszego ruchu (skąd dokąd)
      */
-    std::pair<Coord, Coord> bot_move(const GameState &, PlayerEnum player, HeuristicEnum heuristicType, int depth);
+    std::pair<Coord, Coord> bot_move(const GameState &gameState, HeuristicEnum heuristicType, int depth,
+                                     const SearchFeatures &features = SearchFeatures(),
+                                     const std::function<void(const SearchInfo &)> &progress = nullptr,
+                                     std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+    /**
+     * @brief Analizuje pozycję i zwraca K najlepszych ruchów z dokładnymi ocenami i wariantami głównymi.
+     * @param gameState - rozpatrywany stan gry
+     * @param heuristicType - enumerator używanej heurystyki
+     * @param limits - głębokość, liczba ruchów K (multiPv) i opcjonalny limit węzłów
+     * @param memory - źródło bloków obszaru pamięci przeszukiwania
+     * @return - najlepsze ruchy, od najlepszego dla gracza wykonującego ruch
+     */
+    std::vector<RootMove> analyse(const GameState &gameState, HeuristicEnum heuristicType, const SearchLimits &limits,
+                                  std::pmr::memory_resource *memory = std::pmr::get_default_resource());
     /**
      * @brief Heurystyka bierze pod uwagę ilość własnych bierek i bierek przeciwnika z wagami.
      * @param gameState - rozpatrywany stan gry
@@ -54,15 +76,4 @@ namespace checkers::bot
      * @return - jakość danego stanu
      */
     int estimate_move(const GameState &gameState, HeuristicEnum heuristicType);
-    /**
-     * @brief Implementuje algorytm minimax z przycinaniem alpha-beta
-     * @param gameState - rozpatrywany stan gry
-     * @param depth - głębokość przeszukiwania
-     * @param alpha - wartość zmiennej alfa (alpha-beta pruning)
-     * @param beta - wartość zmiennej beta (alpha-beta pruning)
-     * @param player - gracz wykonujący ruch
-     * @param heuristicType - typ heurystyki jaką posługuje się bot
-     * @return - jakość danego stanu
-     */
-    int minimax(const GameState &gameState, int depth, int alpha, int beta, PlayerEnum player, HeuristicEnum heuristicType);
 } // namespace checkers::bot
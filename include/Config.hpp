@@ -13,6 +13,7 @@
 
 #include <optional>
 #include <string>
+#include <vector>
 
 using std::optional;
 using std::string;
@@ -25,9 +26,60 @@ namespace checkers
      enum HeuristicEnum{
          BASIC,
          A_BASIC,
-         BOARD_AWARE
+         BOARD_AWARE,
+         NNUE,
+         PATTERN
      };
 
+    /** \enum SearchEnum
+     * @brief Algorytm przeszukiwania używany przez bota.
+     */
+    enum SearchEnum
+    {
+        ALPHA_BETA, ///< minimax z przycinaniem alpha-beta
+        MCTS_ROOT,  ///< Monte Carlo Tree Search, osobne drzewo w każdym wątku (root parallel)
+        MCTS_TREE   ///< Monte Carlo Tree Search, wspólne drzewo z wirtualną porażką (tree parallel)
+    };
+
+    /** \enum PlayoutEnum
+     * @brief Sposób rozgrywania symulacji w Monte Carlo Tree Search.
+     */
+    enum PlayoutEnum
+    {
+        RANDOM_PLAYOUT,   ///< losowe ruchy do końca gry
+        HEURISTIC_PLAYOUT ///< oceny heurystyką jako wiedza wstępna węzłów i ucięcie symulacji po kilku ruchach
+    };
+
+    /** \struct MctsOptions
+     * @brief Ustawienia Monte Carlo Tree Search.
+     */
+    struct MctsOptions
+    {
+        /// Liczba symulacji na jeden ruch (łącznie we wszystkich wątkach).
+        int iterations = 20000;
+        /// Opcjonalny limit czasu na jeden ruch w milisekundach.
+        std::optional<int> time = std::nullopt;
+        /// Liczba wątków przeszukiwania.
+        int threads = 1;
+        /// Sposób rozgrywania symulacji.
+        PlayoutEnum playout = RANDOM_PLAYOUT;
+    };
+
+    /** \struct SearchFeatures
+     * @brief Przełączniki przeszukiwania selektywnego, ustawiane osobno dla każdego bota.
+     */
+    struct SearchFeatures
+    {
+        /// Przeszukiwanie późnych cichych ruchów na mniejszej głębokości (late move reductions).
+        bool lateMoveReductions = false;
+        /// Pomijanie cichych ruchów bez szans na poprawę wyniku tuż przed liśćmi (futility pruning).
+        bool futilityPruning = false;
+        /// Przedłużanie przeszukiwania o wymuszone pojedyncze bicia.
+        bool captureExtensions = false;
+        /// Ocenianie rozpoznanych końcówek o znanym wyniku bez dalszego przeszukiwania (Endgame.hpp).
+        bool endgameKnowledge = false;
+    };
+
     struct Config
     {
         /**
@@ -42,6 +94,14 @@ namespace checkers
          * @brief Głębokość przeszukiwania drzewa gry przez białego bota.
          */
         int whiteBotDepth = 3;
+        /**
+         * @brief Techniki przeszukiwania selektywnego używane przez białego bota.
+         */
+        SearchFeatures whiteSearchFeatures;
+        /**
+         * @brief Algorytm przeszukiwania białego bota.
+         */
+        SearchEnum whiteSearch = ALPHA_BETA;
         /**
          * @brief Czy czarnymi steruje bot.
          */
@@ -54,6 +114,18 @@ namespace checkers
          * @brief Głębokość przeszukiwania drzewa gry przez czernego bota.
          */
         int blackBotDepth = 3;
+        /**
+         * @brief Techniki przeszukiwania selektywnego używane przez czarnego bota.
+         */
+        SearchFeatures blackSearchFeatures;
+        /**
+         * @brief Algorytm przeszukiwania czarnego bota.
+         */
+        SearchEnum blackSearch = ALPHA_BETA;
+        /**
+         * @brief Ustawienia Monte Carlo Tree Search, wspólne dla obu botów.
+         */
+        MctsOptions mcts;
         /**
          * @brief Ścieżka do pliku z logami rozgrywki
          */
@@ -62,8 +134,96 @@ namespace checkers
          * @brief Czy uruchomić GUI.
          */
          bool showGUI = true;
+        /**
+         * @brief Czy widok ma pokazywać panel ze statystykami przeszukiwania botów.
+         */
+        bool showStats = false;
+        /**
+         * @brief Czy uruchomić tryb silnika komunikującego się tekstowym protokołem przez stdin/stdout.
+         */
+        bool engineMode = false;
+        /**
+         * @brief Ścieżka do pliku wag sieci heurystyki NNUE. Bez niej używana jest sieć startowa.
+         */
+        std::optional<string> nnuePath = std::nullopt;
+        /**
+         * @brief Ścieżka, pod którą zapisać wagi sieci startowej NNUE. Jeśli podana, program kończy pracę po zapisie.
+         */
+        std::optional<string> nnueSavePath = std::nullopt;
+        /**
+         * @brief Ścieżka do pliku tablic wzorców heurystyki PATTERN. Bez niej używane są tablice wbudowane.
+         */
+        std::optional<string> patternsPath = std::nullopt;
+        /**
+         * @brief Ścieżka, pod którą zapisać wygenerowane tablice wzorców. Jeśli podana, program kończy pracę po zapisie.
+         */
+        std::optional<string> patternsSavePath = std::nullopt;
+        /**
+         * @brief Ścieżka do pliku z zestawem pozycji testowych. Jeśli podana, program rozwiązuje zestaw i kończy pracę.
+         */
+        std::optional<string> suitePath = std::nullopt;
+        /**
+         * @brief Limit czasu na jedną pozycję zestawu w milisekundach.
+         */
+        int suiteTime = 1000;
+        /**
+         * @brief Limit węzłów na jedną pozycję zestawu. Jeśli podany, zastępuje limit czasu (wyniki są powtarzalne).
+         */
+        std::optional<long long> suiteNodes = std::nullopt;
+        /**
+         * @brief Liczba wątków rozwiązujących zestaw pozycji (0 - tyle ile rdzeni procesora).
+         */
+        int threads = 0;
+        /**
+         * @brief Ścieżka do pliku, do którego zapisać przebieg programu w formacie Chrome trace event.
+         */
+        std::optional<string> tracePath = std::nullopt;
+        /**
+         * @brief Czy liczyć alokacje i zajętą pamięć w trakcie ruchów bota (zapisywane do logu).
+         */
+        bool memoryStats = false;
+        /**
+         * @brief Pliki z zapisanymi partiami do sprawdzenia. Jeśli podane, program sprawdza partie i kończy pracę.
+         */
+        std::vector<string> replayPaths;
+        /**
+         * @brief Ścieżka pliku JSON z wynikami pomiaru wydajności. Jeśli podana, program wykonuje pomiar i kończy pracę.
+         */
+        std::optional<string> benchPath = std::nullopt;
+        /**
+         * @brief Plik JSON z bazowymi wynikami pomiaru wydajności, z którymi porównywany jest pomiar.
+         */
+        std::optional<string> benchBaseline = std::nullopt;
+        /**
+         * @brief Dopuszczalne wydłużenie czasu pomiaru względem bazowego w procentach.
+         */
+        double benchTolerance = 20.0;
+        /**
+         * @brief Dopuszczalna zmiana liczby węzłów względem bazowej w procentach.
+         */
+        double benchNodeTolerance = 0.0;
+        /**
+         * @brief Liczba powtórzeń każdego pomiaru (liczy się najkrótszy czas).
+         */
+        int benchRuns = 5;
 
         static std::optional<Config> try_from_args(int argc, char *argv[]);
     };
 
+    /**
+     * @brief Odczytuje nazwę heurystyki (basic/a_basic/board_aware/nnue/pattern).
+     *
+     * @param name - nazwa heurystyki
+     * @return std::optional<HeuristicEnum> - heurystyka lub nullopt jeśli nazwa jest nieznana
+     */
+    std::optional<HeuristicEnum> heuristic_from_string(const std::string &name);
+
+    /**
+     * @brief Odczytuje nazwę algorytmu przeszukiwania (alphabeta/mcts_root/mcts_tree).
+     *
+     * @param name - nazwa algorytmu
+     * @return std::optional<SearchEnum> - algorytm lub nullopt jeśli nazwa jest nieznana
+     */
+    std::optional<SearchEnum> search_from_string(const std::string &name);
+
 } // namespace checkers
@@ -16,9 +16,14 @@
 #include "MessageQueues.hpp"
 #include "Game.hpp"
 #include "Config.hpp"
+#include "Search.hpp"
+#include "Memory.hpp"
 
 namespace checkers
 {
+    /// Czas kroku przeszukiwania bota, po którym kontroler sprawdza akcje gracza.
+    constexpr std::chrono::milliseconds CONTROLLER_SEARCH_SLICE{50};
+
     /**
      * @brief Kontroler gry.
      *        Przyjmuje ruchy graczy, wywołuje ruchy botów i rozgrywa grę.
@@ -45,12 +50,16 @@ namespace checkers
         /// Stan razgrywki.
         GameState gameState;
         std::optional<Coord> selectedField;
+        /// Dozwolone ruchy w obecnym stanie gry, odświeżane po każdym ruchu.
+        LegalMoveSet legalMoves;
         /// Pośrednik komunikacji z widokiem.
         std::shared_ptr<MessageQueues> messageQueues;
         /// Uchwyt do pliku z logami rozgrywki
         std::optional<std::ofstream> logFile;
         /// Moment w czasie służacy do pomiaru czasu ruchu bota
         std::optional<std::chrono::time_point<std::chrono::steady_clock>> lastMoveStart;
+        /// Statystyki botów wysyłane do widoku.
+        StatsMessage stats;
 
         /// Czy w grze jest gracz który nie jest botem.
         bool has_human_player() const;
@@ -58,8 +67,18 @@ namespace checkers
         bool need_player_input() const;
         /// Odbierz akcję gracza od widoku.
         PlayerInputMessage get_player_input();
+        /// Wybierz ruch bota przeszukiwaniem alpha-beta, przeplatanym z odbieraniem akcji gracza.
+        std::optional<std::pair<Coord, Coord>> search_move(HeuristicEnum heuristic, int depth,
+                                                           const SearchFeatures &features,
+                                                           const std::function<void(const bot::SearchInfo &)> &progress);
         /// Wyślij obacny stan gry do widoku.
         void send_state() const;
+        /// Wyślij do widoku statystyki rozpoczynanego przeszukiwania.
+        void publish_search_start(int maxDepth);
+        /// Wyślij do widoku postęp przeszukiwania bota.
+        void publish_search_progress(const bot::SearchInfo &info);
+        /// Wyślij do widoku statystyki zakończonego przeszukiwania wraz z czasem ruchu.
+        void publish_search_end(std::chrono::steady_clock::duration latency);
         /// Zakończ pracę kontrolera, zapisz stan gry jeśli była w trakcie.
         void exit();
         /// Spróbuj zapisać do logu informację o rozpoczętej grze.
@@ -67,7 +86,11 @@ namespace checkers
         /// Spróbuj zapisać do logu informację o rozpoczęciu ruchu.
         void try_log_start_move();
         /// Spróbuj zapisać do logu informację o zakończeniu ruchu.
-        void try_log_end_move();
+        void try_log_end_move(const std::string &move);
+        /// Spróbuj zapisać do logu alokacje i pamięć zajętą przez ruch bota (--memstats).
+        void try_log_memory(const memory::AllocationCounters &allocations);
+        /// Zapis ruchu w obecnym stanie gry, przed jego wykonaniem.
+        std::string move_text(Coord from, Coord to) const;
         /// Spróbuj zapisać do logu wynik rozgrywki.
         void try_log_end_game();
     };
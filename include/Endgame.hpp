@@ -0,0 +1,73 @@
+/**
+ * @file Endgame.hpp
+ * @author Bartosz Świrta
+ * @brief Zawiera deklarację rozpoznawania końcówek o znanym wyniku, sprawdzanego przed dalszym przeszukiwaniem.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <optional>
+
+#include "Game.hpp"
+
+namespace checkers::bot
+{
+    /// Ocena rozpoznanej wygranej (do niej dodawana jest przewaga materialna). Mniejsza od oceny zakończonej gry.
+    constexpr int ENDGAME_WIN = 500;
+    /// Przewaga liczby bierek, od której końcówka z królową przeciwko samym pionom uznawana jest za wygraną.
+    constexpr int ENDGAME_OVERWHELMING_LEAD = 3;
+    /// Najmniejsza liczba ruchów samotnej królowej, przy której remis uznawany jest bez przeszukiwania.
+    constexpr int ENDGAME_ESCAPE_MOVES = 4;
+    /// Liczba ruchów silniejszej strony, których w najgorszym razie potrzebują trzy królowe z główną
+    /// przekątną, żeby złapać samotną królową (stąd oficjalny limit 15 ruchów w tej końcówce).
+    constexpr int ENDGAME_QUEENS_WIN_MOVES = 12;
+    /// Liczba półruchów królowymi bez bicia, poniżej której trzy królowe zdążą wygrać przed remisem
+    /// po RussianRules::QUEEN_MOVES_TIE półruchach (każdy ich ruch to dwa półruchy).
+    constexpr int ENDGAME_QUEENS_WIN_TURNS = RussianRules::QUEEN_MOVES_TIE - 2 * ENDGAME_QUEENS_WIN_MOVES;
+    static_assert(ENDGAME_QUEENS_WIN_TURNS > 0, "three queens must have time to win before the draw");
+
+    /** \enum EndgameBoundEnum
+     * @brief Rodzaj oceny rozpoznanej końcówki.
+     */
+    enum EndgameBoundEnum
+    {
+        /// Ocena dokładna (remis).
+        ENDGAME_EXACT,
+        /// Dokładna ocena jest co najmniej taka (wygrana białych).
+        ENDGAME_LOWER,
+        /// Dokładna ocena jest co najwyżej taka (wygrana czarnych).
+        ENDGAME_UPPER
+    };
+
+    /** \struct EndgameScore
+     * @brief Ocena rozpoznanej końcówki z perspektywy białych (jak w estimate_move).
+     */
+    struct EndgameScore
+    {
+        int score;
+        EndgameBoundEnum bound;
+    };
+
+    /**
+     * @brief Rozpoznaje końcówki warcabów rosyjskich o znanym wyniku.
+     * @details Rozpoznawane są tylko pozycje bez bicia dla gracza wykonującego ruch:
+     *          - królowa przeciwko jednej lub dwóm królowym - remis,
+     *          - trzy królowe przeciwko królowej na głównej przekątnej (a1-h8), na której nie ma
+     *            królowych przeciwnika - remis,
+     *          - trzy królowe, z których jedna zajmuje główną przekątną, przeciwko królowej poza nią -
+     *            wygrana, jeśli do remisu z reguły ruchów królowymi zostało dość tur,
+     *          - co najmniej jedna królowa i przewaga ENDGAME_OVERWHELMING_LEAD bierek przeciwko
+     *            samym pionom - wygrana.
+     *          Remis uznawany jest tylko gdy ruch ma samotna królowa i ma co najmniej
+     *          ENDGAME_ESCAPE_MOVES ruchów, bo zepchniętą do rogu da się złapać.
+     *          Wygrana to ograniczenie oceny: ENDGAME_WIN z przewagą materialną.
+     * @param gameState - rozpatrywany stan gry
+     * @return std::optional<EndgameScore> - ocena lub nullopt jeśli końcówka nie jest rozpoznana
+     */
+    std::optional<EndgameScore> recognize_endgame(const GameState &gameState);
+} // namespace checkers::bot
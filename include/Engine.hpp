@@ -0,0 +1,89 @@
+/**
+ * @file Engine.hpp
+ * @author Bartosz Świrta
+ * @brief Zawiera definicję klasy Engine - trybu silnika sterowanego tekstowym protokołem przez stdin/stdout.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "Game.hpp"
+#include "Config.hpp"
+#include "Search.hpp"
+
+namespace checkers
+{
+    /**
+     * @brief Silnik gry sterowany tekstowym protokołem liniowym.
+     * @details Jeden długo działający proces obsługuje wiele gier i przeszukiwań zlecanych
+     *          przez zewnętrzny program. Obsługiwane polecenia:
+     *          - isready - odpowiedź "readyok",
+     *          - newgame - ustawienie pozycji początkowej,
+     *          - position (startpos|fen (zapis pozycji)) [moves c3-d4 ...] - ustawienie pozycji,
+     *          - setoption name (heuristic|multipv|lmr|futility|extensions|endgame) value (wartość),
+     *          - go [depth N] [movetime ms] [nodes N] [infinite] - rozpoczęcie przeszukiwania,
+     *          - stop - przerwanie przeszukiwania,
+     *          - quit - zakończenie pracy.
+     *          Przeszukiwanie wypisuje po każdej iteracji linie "info depth ... nodes ... nps ... pv ...",
+     *          a na koniec "bestmove (ruch)". Oceny podawane są z perspektywy gracza wykonującego ruch.
+     *          Heurystyka i techniki przeszukiwania selektywnego są na starcie brane z ustawień białego
+     *          komputera (--wheuristic, --wlmr, --wfutility, --wextend, --wendgame), a setoption je zmienia.
+     */
+    class Engine
+    {
+    public:
+        /**
+         * @brief Konstruktor silnika z ustawieniami białego komputera z podanej konfiguracji.
+         *
+         */
+        explicit Engine(const Config &config_);
+        ~Engine();
+        /**
+         * @brief Uruchamia pętlę obsługi poleceń, przejmuje wątek do polecenia quit lub końca wejścia.
+         *
+         */
+        void run();
+
+    private:
+        /// Pozycja, z której rozpoczynane jest przeszukiwanie.
+        GameState gameState;
+        /// Heurystyka używana przez przeszukiwanie.
+        HeuristicEnum heuristicType = BASIC;
+        /// Liczba analizowanych najlepszych ruchów.
+        int multiPv = 1;
+        /// Techniki przeszukiwania selektywnego.
+        SearchFeatures features;
+        /// Przeszukiwanie, zachowywane pomiędzy kolejnymi poleceniami go.
+        std::unique_ptr<bot::Search> search;
+        /// Wątek, w którym trwa przeszukiwanie.
+        std::thread searchThread;
+        /// Flaga przerwania przeszukiwania.
+        std::atomic<bool> stopSignal{false};
+        /// Mutex chroniący wyjście przed przeplataniem linii z różnych wątków.
+        std::mutex outputMutex;
+
+        /// Obsługa polecenia position.
+        void set_position(std::istringstream &args);
+        /// Obsługa polecenia setoption.
+        void set_option(std::istringstream &args);
+        /// Obsługa polecenia go, uruchamia przeszukiwanie w osobnym wątku.
+        void go(std::istringstream &args);
+        /// Przerywa trwające przeszukiwanie i czeka na jego zakończenie.
+        void stop();
+        /// Wypisuje linie info z podsumowaniem iteracji.
+        void send_info(const GameState &root, const bot::SearchInfo &info);
+        /// Wypisuje jedną linię odpowiedzi.
+        void send(const std::string &line);
+    };
+
+} // namespace checkers
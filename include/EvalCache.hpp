@@ -0,0 +1,101 @@
+/**
+ * @file EvalCache.hpp
+ * @author Bartosz Świrta
+ * @brief Zawiera deklarację klasy EvalCache - tablicy statycznych ocen pozycji współdzielonej
+ *        przez przeszukiwania.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "Config.hpp"
+
+namespace checkers::bot
+{
+    /// Liczba wpisów tablicy ocen (potęga dwójki, po jednej linii pamięci podręcznej na wpis).
+    constexpr std::size_t EVAL_CACHE_ENTRIES = std::size_t(1) << 15;
+    /// Rozmiar linii pamięci podręcznej procesora.
+    constexpr std::size_t CACHE_LINE_BYTES = 64;
+    /// Liczba heurystyk, dla których wpis przechowuje ocenę.
+    constexpr int HEURISTIC_COUNT = PATTERN + 1;
+    /// Co która ocena spoza tablicy jest mierzona, żeby oszacować czas zaoszczędzony przez trafienia.
+    constexpr std::uint64_t EVAL_TIMING_INTERVAL = 64;
+
+    /** \struct EvalCacheStats
+     * @brief Statystyki tablicy ocen w jednym przeszukiwaniu.
+     */
+    struct EvalCacheStats
+    {
+        /// Liczba zapytań o ocenę.
+        std::uint64_t probes = 0;
+        /// Liczba ocen znalezionych w tablicy.
+        std::uint64_t hits = 0;
+        /// Szacowany czas ocen, których nie trzeba było liczyć (trafienia razy średni czas oceny).
+        std::chrono::microseconds saved{0};
+
+        /**
+         * @return Odsetek trafień w procentach (0 bez zapytań).
+         */
+        double hit_rate() const;
+    };
+
+    /**
+     * @brief Tablica statycznych ocen pozycji adresowana bezpośrednio 64-bitowym skrótem pozycji.
+     * @details Wpis zajmuje jedną linię pamięci podręcznej i przechowuje ocenę dla każdej heurystyki,
+     *          więc przeszukiwania różnymi heurystykami nie wypierają sobie ocen tej samej pozycji.
+     *          Nowa ocena zastępuje poprzednią ocenę tą samą heurystyką, niezależnie od pozycji.
+     *          Tablica jest oddzielna od wyników przeszukiwania - przechowuje tylko oceny liści.
+     *
+     *          Dostęp nie wymaga blokad: ocena i starsza połowa skrótu (młodsza wybiera wpis) zapisywane
+     *          są razem jako jedno słowo atomowe, więc odczyt nigdy nie łączy danych dwóch zapisów
+     *          i wiele wątków (np. MCTS w trybie mcts_tree) może współdzielić jedną tablicę.
+     */
+    class EvalCache
+    {
+    public:
+        EvalCache();
+        /**
+         * @brief Szuka oceny pozycji.
+         * @param hash - skrót pozycji (GameState::get_hash)
+         * @param heuristicType - heurystyka oceny
+         * @return std::optional<int> - ocena lub nullopt jeśli jej nie ma w tablicy
+         */
+        std::optional<int> probe(std::uint64_t hash, HeuristicEnum heuristicType) const;
+        /**
+         * @brief Zapisuje ocenę pozycji, zastępując ocenę tą samą heurystyką zapisaną we wpisie.
+         */
+        void store(std::uint64_t hash, HeuristicEnum heuristicType, int score);
+        /**
+         * @brief Usuwa wszystkie oceny (np. po zmianie sieci NNUE).
+         */
+        void clear();
+
+    private:
+        /// Wpis tablicy: oceny jednej pozycji wszystkimi heurystykami w jednej linii pamięci podręcznej.
+        /// Słowo oceny to starsza połowa skrótu (z najmłodszym bitem ustawionym, żeby zero
+        /// oznaczało puste miejsce) i ocena w młodszej połowie.
+        struct alignas(CACHE_LINE_BYTES) Entry
+        {
+            std::atomic<std::uint64_t> slots[HEURISTIC_COUNT];
+        };
+        static_assert(sizeof(Entry) == CACHE_LINE_BYTES, "wpis tablicy ocen musi zajmować jedną linię");
+
+        std::unique_ptr<Entry[]> entries;
+    };
+
+    /**
+     * @return Tablica ocen współdzielona przez wszystkie przeszukiwania w procesie.
+     */
+    EvalCache &shared_eval_cache();
+
+} // namespace checkers::bot
@@ -12,7 +12,12 @@
 
 #include <optional>
 #include <vector>
+#include <string>
 #include <iostream>
+#include <type_traits>
+
+#include "Squares.hpp"
+#include "Rules.hpp"
 
 namespace checkers
 {
@@ -20,7 +25,7 @@ namespace checkers
      * @brief Możliwe stany fazy rozgrywki.
      * 
      */
-    enum GameProgressEnum
+    enum GameProgressEnum : std::uint8_t
     {
         PLAYING,
         WHITE_WON,
@@ -32,7 +37,7 @@ namespace checkers
      * @brief Konkretny gracz.
      * 
      */
-    enum PlayerEnum
+    enum PlayerEnum : std::uint8_t
     {
         WHITE,
         BLACK
@@ -78,20 +83,123 @@ namespace checkers
         }
     };
 
-    /** \struct BoardState
+    /// Czy współrzędne wskazują grywalne (ciemne) pole planszy.
+    inline bool is_playable(Coord field) {
+        return squares::is_playable(field.x, field.y);
+    }
+
+    /// Indeks grywalnego pola o podanych współrzędnych.
+    inline Square to_square(Coord field) {
+        return squares::to_square(field.x, field.y);
+    }
+
+    /// Współrzędne pola o podanym indeksie.
+    inline Coord to_coord(Square square) {
+        return Coord(squares::square_x(square), squares::square_y(square));
+    }
+
+    /** \struct Move
+     * @brief Pojedynczy ruch bierki (jeden krok, także w łańcuchu bić).
+     */
+    struct Move
+    {
+        /// Pole na którym stoi bierka.
+        Square from;
+        /// Pole docelowe.
+        Square to;
+    };
+
+    /**
+     * @brief Lista ruchów o stałej pojemności, alokowana na stosie.
+     * @details Zastępuje std::vector w generatorze ruchów, żeby przeszukiwanie drzewa gry
+     *          nie alokowało pamięci na stercie w każdym węźle.
+     */
+    template<int CAPACITY>
+    class BasicMoveList
+    {
+    public:
+        /// Maksymalna liczba ruchów.
+        static constexpr int MAX_MOVES = CAPACITY;
+
+        void push_back(Move move) { moves[count++] = move; }
+        void clear() { count = 0; }
+        int size() const { return count; }
+        bool empty() const { return count == 0; }
+        const Move &operator[](int i) const { return moves[i]; }
+        const Move *begin() const { return moves; }
+        const Move *end() const { return moves + count; }
+
+    private:
+        Move moves[MAX_MOVES];
+        int count = 0;
+    };
+
+    /// Lista ruchów planszy 8x8: 12 bierek gracza, każda ma najwyżej 13 pól docelowych.
+    using MoveList = BasicMoveList<12 * 13>;
+
+    /** \struct BasicBoardState
      * @brief Stan planszy gry.
      */
-    struct BoardState
+    template<int SIZE>
+    struct BasicBoardState
+    {
+        std::optional<PieceEnum> fields[SIZE][SIZE];
+    };
+
+    using BoardState = BasicBoardState<8>;
+
+    /** \struct SideTraits
+     * @brief Stałe generatora ruchów zależne od gracza wykonującego ruch, znane w czasie kompilacji.
+     */
+    template<PlayerEnum Side>
+    struct SideTraits
     {
-        std::optional<PieceEnum> fields[8][8];
+        /// Przeciwnik gracza Side.
+        static constexpr PlayerEnum ENEMY = Side == WHITE ? BLACK : WHITE;
+        /// Kierunki ruchu piona (do przodu), w kolejności generowania ruchów.
+        static constexpr DirectionEnum STEPS[2] = {Side == WHITE ? UP_LEFT : DOWN_LEFT,
+                                                   Side == WHITE ? UP_RIGHT : DOWN_RIGHT};
+        /// Kierunki bicia piona: najpierw dwa do przodu, potem do tyłu.
+        static constexpr DirectionEnum JUMPS[4] = {Side == WHITE ? UP_LEFT : DOWN_LEFT,
+                                                   Side == WHITE ? UP_RIGHT : DOWN_RIGHT,
+                                                   Side == WHITE ? DOWN_LEFT : UP_RIGHT,
+                                                   Side == WHITE ? DOWN_RIGHT : UP_LEFT};
+
+        /// Czy kierunek prowadzi do przodu.
+        static constexpr bool is_forward(int direction) {
+            return Side == WHITE ? direction == UP_RIGHT || direction == UP_LEFT
+                                 : direction == DOWN_RIGHT || direction == DOWN_LEFT;
+        }
+        /// Rząd, na którym pion gracza zostaje królową.
+        template<class Board>
+        static constexpr int promotion_row() {
+            return Side == WHITE ? Board::BOARD_SIZE - 1 : 0;
+        }
     };
 
     /**
      * @brief Stan gry. Pozwala na modyfikację tylko poprzez prowadzenie poprawnej rozgrywki.
+     * @details Stan jest trywialnie kopiowalny: bierki zapisane są w maskach bitowych grywalnych pól,
+     *          a historia do wykrywania powtórzeń w tablicy 32-bitowych odcisków pozycji.
+     *          Geometria planszy i reguły wariantu (Rules.hpp) są parametrami szablonu, więc
+     *          różnice między wariantami rozstrzygane są w czasie kompilacji. Generator ruchów
+     *          jest też szablonem gracza wykonującego ruch (SideTraits), a publiczne metody
+     *          wybierają jego wersję raz na wywołanie. Definicje metod
+     *          znajdują się w Game.cpp, który jawnie konkretyzuje szablon dla RussianRules,
+     *          EnglishRules i InternationalRules.
      */
-    class GameState
+    template<class Rules>
+    class BasicGameState
     {
     public:
+        using Board = typename Rules::Board;
+        using Mask = typename Board::Mask;
+        /// Maksymalna liczba ruchów: wszystkie piony gracza, każdy z największą liczbą pól docelowych.
+        using MoveListType = BasicMoveList<Rules::PAWN_ROWS * Board::ROW_SQUARES * Board::MAX_TARGETS>;
+        /// Liczba zapamiętanych odcisków pozycji. Historia jest czyszczona razem z licznikiem ruchów
+        /// królowymi, więc do remisu nigdy nie zawiera więcej niż QUEEN_MOVES_TIE pozycji.
+        static constexpr int HISTORY_SIZE = Rules::QUEEN_MOVES_TIE;
+
         /**
          * @brief Inicjalizacja początkowego stanu gry.
          */
@@ -99,7 +207,7 @@ namespace checkers
         /**
          * @return Kopia stanu planszy.
          */
-        BoardState get_board_state() const;
+        BasicBoardState<Board::BOARD_SIZE> get_board_state() const;
         /**
          * @return Gracz który obecnie ma wykonać ruch.
          */
@@ -112,6 +220,18 @@ namespace checkers
          * @return Kopia pola o podanych współrzędnych.
          */
         std::optional<PieceEnum> get_field(Coord field) const;
+        /**
+         * @return Kopia pola o podanym indeksie.
+         */
+        std::optional<PieceEnum> get_square(Square square) const;
+        /**
+         * @return Maska pól z bierkami podanego gracza.
+         */
+        Mask get_pieces(PlayerEnum player) const;
+        /**
+         * @return Maska pól z królowymi obu graczy.
+         */
+        Mask get_queens() const;
         /**
          * @return Czy można wybrać to pole = czy na tym polu jest bierka, która ma możliwy ruch.
          */
@@ -124,6 +244,13 @@ namespace checkers
          * @return Czy udało się wykonać ten ruch.
          */
         bool try_make_move(Coord from, Coord to);
+        /**
+         * @brief Próba wykonania ruchu podanego indeksami pól.
+         *
+         * @param move Ruch (skąd, dokąd).
+         * @return Czy udało się wykonać ten ruch.
+         */
+        bool try_make_move(Move move);
         /**
          * @return Ostatni ruch obecnego gracza (istnieje jeśli jesteśmy w trakcie łańcucha bić).
          */
@@ -136,6 +263,28 @@ namespace checkers
          * @return Czy można wykonać taki ruch.
          */
         bool can_move_piece(Coord from, Coord to) const;
+        /**
+         * @return 32-bitowy odcisk układu bierek na planszy (bez gracza wykonującego ruch).
+         */
+        std::uint32_t get_fingerprint() const;
+        /**
+         * @return 64-bitowy skrót pozycji: układu bierek i gracza wykonującego ruch.
+         */
+        std::uint64_t get_hash() const;
+        /**
+         * @return Liczba tur wykonanych królowymi bez bicia od ostatniego nieodwracalnego ruchu.
+         *         Każda taka tura to jeden ruch, więc jest to też liczba ostatnich ruchów,
+         *         wśród których może powtórzyć się obecna pozycja.
+         */
+        int get_reversible_moves() const;
+        /**
+         * @return Czy obecny gracz ma obowiązek bicia (wszystkie jego możliwe ruchy są biciami).
+         */
+        bool must_capture() const;
+        /**
+         * @return Wszystkie możliwe ruchy obecnego gracza, wygenerowane w jednym przejściu po planszy.
+         */
+        MoveListType legal_moves() const;
         /**
          * @return Wektor pozycji na których stoją bierki, które mają mozliwy ruch.
          */
@@ -144,22 +293,51 @@ namespace checkers
          * @return Lista możliwych ruchów bierki stojącej na polu o podanych współrzędnych.
          */
         std::vector<Coord> piece_moves(Coord field) const;
+        /**
+         * @brief Zapis pozycji, np. "bbbb/bbbb/bbbb/..../..../wwww/wwww/wwww w -".
+         * @details Rzędy od ostatniego do 1 oddzielone '/', w każdym grywalne pola od lewej:
+         *          'w' i 'b' to piony, 'W' i 'B' królowe, '.' puste pole. Dalej gracz wykonujący
+         *          ruch (w/b) oraz pole bierki w trakcie łańcucha bić lub '-'.
+         * @return Zapis pozycji.
+         */
+        std::string to_string() const;
+        /**
+         * @brief Próbuje odtworzyć stan gry z zapisu pozycji (jak w to_string).
+         * @details Historia potrzebna do wykrywania remisu zaczyna się od odczytanej pozycji.
+         *
+         * @param text Zapis pozycji.
+         * @return Stan gry lub nullopt jeśli zapis jest niepoprawny.
+         */
+        static std::optional<BasicGameState> try_from_string(const std::string &text);
 
     private:
-        /// Obecny stan planszy.
-        BoardState board;
+        /// Maska pól z bierkami białych.
+        Mask white = 0;
+        /// Maska pól z bierkami czarnych.
+        Mask black = 0;
+        /// Maska pól z królowymi (obu graczy).
+        Mask queens = 0;
+        /// Maska pól z bierkami obecnego gracza, które mają dostępne bicie.
+        /// Liczona raz dla każdej pozycji (w init i try_make_move), niezerowa oznacza obowiązek bicia.
+        Mask attackers = 0;
+        /// Bierki zbite w trwającym łańcuchu bić (tylko przy REMOVE_CAPTURED_AT_END).
+        Mask captured = 0;
+        /// Odciski poprzednich stanów planszy (po zakończeniu każdej tury).
+        /// Czyszczone po wykonaniu nieodwracalnego ruchu (ruch pionkiem lub bicie).
+        std::uint32_t history[HISTORY_SIZE];
         /// Gracz który ma wykonać następny ruch.
-        PlayerEnum currentPlayer;
+        PlayerEnum currentPlayer = WHITE;
         /// Obecna faza rozgrywki.
-        GameProgressEnum gameProgress;
+        GameProgressEnum gameProgress = PLAYING;
         /// Poprzedni ruch w łańcuchu bić.
-        /// Staje się std::nullopt po skończeniu tury gracza.
-        std::optional<Coord> lastMove;
+        /// Staje się NO_SQUARE po skończeniu tury gracza.
+        Square lastMove = NO_SQUARE;
         /// Ilość ruchów pod rząd wykonanych królowymi bez bicia.
-        int queenMovesNoTake = 0;
-        /// Poprzednie stany planszy.
-        /// Czyszczone po wykonaniu nieodwracalnego ruchu (ruch pionkiem lub bicie).
-        std::vector<std::string> pastBoardStates;
+        std::uint8_t queenMovesNoTake = 0;
+        /// Liczba zapisanych odcisków w history.
+        std::uint8_t historyCount = 0;
+        /// Długość najdłuższego dostępnego bicia (tylko przy MAXIMUM_CAPTURE).
+        std::uint8_t maxCapture = 0;
 
         /**
          * @brief Ustawia wartość pola.
@@ -167,25 +345,59 @@ namespace checkers
          * @param field Koordynaty pola.
          * @param piece Enumerator bierki.
          */
-        void set_field(Coord field, std::optional<PieceEnum> piece);
+        void set_field(Square field, std::optional<PieceEnum> piece);
+        /**
+         * @brief Wykonuje krok ruchu na planszy (przestawienie, bicie i promocja), bez sprawdzania poprawności.
+         *
+         * @param from Obecna pozycja bierki.
+         * @param to Pole docelowe.
+         * @return Czy bierka kontynuuje łańcuch bić.
+         */
+        bool make_step(Square from, Square to);
+        /// make_step dla ruchu gracza Side.
+        template<PlayerEnum Side>
+        bool make_step(Square from, Square to);
+        /**
+         * @brief Najdłuższy łańcuch bić bierki stojącej na podanym polu.
+         *
+         * @param field Pole bierki.
+         * @return Liczba bierek zbitych w najdłuższym łańcuchu.
+         */
+        int longest_capture(Square field) const;
+        /// longest_capture dla bierki gracza Side.
+        template<PlayerEnum Side>
+        int longest_capture(Square field) const;
+        /**
+         * @brief Liczba bierek zbitych w najdłuższym łańcuchu zaczynającym się od podanego bicia.
+         *
+         * @param from Obecna pozycja bierki.
+         * @param to Pole lądowania po biciu.
+         * @return Długość łańcucha.
+         */
+        int capture_length(Square from, Square to) const;
+        /// capture_length dla bicia gracza Side.
+        template<PlayerEnum Side>
+        int capture_length(Square from, Square to) const;
         /**
          * @brief Wykonuje ruch bierką. Przestawia ją z pola obecnego na pole docelowe.
          * 
          * @param src Obecna pozycja bierki.
          * @param dst Pole docelowe.
          */
-        void move_piece(Coord src, Coord dst);
+        void move_piece(Square src, Square dst);
         /**
          * @brief Decyduje, który gracz wykonuje ruch jako kolejny.
          * 
          */
         void flip_current_player();
         /**
-         * @brief Zlicza bierki obecnego gracza, które mają dostępne bicie.
+         * @brief Wyznacza maskę bierek obecnego gracza, które mają dostępne bicie.
          * 
-         * @return int liczba bierek z biciem.
          */
-        int count_pieces_with_attack() const;
+        void update_attackers();
+        /// update_attackers, gdy ruch ma gracz Side.
+        template<PlayerEnum Side>
+        void update_attackers();
         /**
          * @brief Sprawdza możliwość ruchu bez weryfikacji czy bierka ma dostępne bicia.
          * 
@@ -194,7 +406,8 @@ namespace checkers
          * @return true Można wykonać ruch.
          * @return false Nie można wykonać ruchu.
          */
-        bool can_move_piece_relaxed(Coord from, Coord to) const;
+        template<PlayerEnum Side>
+        bool can_move_piece_relaxed(Square from, Square to) const;
         /**
          * @brief Czy bierka ma dostępne bicie.
          * 
@@ -202,9 +415,10 @@ namespace checkers
          * @return true 
          * @return false 
          */
-        bool piece_has_attacks(Coord field) const;
+        template<PlayerEnum Side>
+        bool piece_has_attacks(Square field) const;
         /**
-         * @brief Zapisuje zakodowany stan planszy. Stany te pozwalają wykryć remis.
+         * @brief Zapisuje odcisk stanu planszy. Odciski pozwalają wykryć remis.
          * 
          */
         void push_past_board_state();
@@ -229,7 +443,7 @@ namespace checkers
          * @return true Między polami nie ma bierki.
          * @return false Między polami jest bierka.
          */
-        bool is_empty_between(Coord start, Coord end) const;
+        bool is_empty_between(Square start, Square end) const;
         /**
          * @brief Sprawdza czy między polami jest tylko jedna bierka.
          * 
@@ -238,7 +452,8 @@ namespace checkers
          * @return true Między polami jest tylko jedna bierka.
          * @return false Między polami nie ma żadnej bierki.
          */
-        bool is_only_one_enemy_between(Coord start, Coord end) const;
+        template<PlayerEnum Side>
+        bool is_only_one_enemy_between(Square start, Square end) const;
         /**
          * @brief Aktualizuje stan rozgrywki.
          * 
@@ -251,26 +466,117 @@ namespace checkers
          * @return true 
          * @return false 
          */
-        bool is_current_player_piece(Coord field) const;
+        bool is_current_player_piece(Square field) const;
         /**
-         * @brief Czy bierka należy do przeciwnika.
-         * 
-         * @param field Koordynaty bierki.
-         * @return true 
-         * @return false 
+         * @return Maska bierek gracza Side.
+         */
+        template<PlayerEnum Side>
+        Mask own_pieces() const;
+        /**
+         * @return Maska bierek przeciwnika gracza Side, które można zbić.
          */
-        bool is_enemy_player_piece(Coord field) const;
+        template<PlayerEnum Side>
+        Mask enemy_pieces() const;
         /**
          * @brief Ściąga zbity pion z planszy.
          * 
          * @param start Pole początkowe ruchu.
          * @param end Pole końcowe ruchu.
          */
-        void clear_between(Coord start, Coord end);
+        void clear_between(Square start, Square end);
+        /**
+         * @brief Dopisuje do listy możliwe ruchy bierki stojącej na podanym polu.
+         *
+         * @param field Koordynaty bierki.
+         * @param moves Lista do której dopisywane są ruchy.
+         */
+        void append_piece_moves(Square field, MoveListType &moves) const;
+        /// append_piece_moves, gdy ruch ma gracz Side.
+        template<PlayerEnum Side>
+        void append_piece_moves(Square field, MoveListType &moves) const;
+        /**
+         * @brief Dopisuje do listy ruchy bierki bez ograniczenia do najdłuższych bić.
+         *
+         * @param field Koordynaty bierki.
+         * @param hasAttacks Czy bierka ma dostępne bicie (dopisywane są wtedy tylko bicia).
+         * @param moves Lista do której dopisywane są ruchy.
+         */
+        template<PlayerEnum Side>
+        void append_piece_targets(Square field, bool hasAttacks, MoveListType &moves) const;
+        /**
+         * @brief Sprawdza możliwość ruchu podanego indeksami pól.
+         *
+         * @param from Obecne pozycja bierki.
+         * @param to Pole docelowe.
+         * @return Czy można wykonać taki ruch.
+         */
+        bool can_move_piece(Square from, Square to) const;
+        /// can_move_piece, gdy ruch ma gracz Side.
+        template<PlayerEnum Side>
+        bool can_move_piece(Square from, Square to) const;
+        /// try_make_move, gdy ruch ma gracz Side.
+        template<PlayerEnum Side>
+        bool try_make_move(Move move);
+        /// legal_moves, gdy ruch ma gracz Side.
+        template<PlayerEnum Side>
+        MoveListType legal_moves() const;
+    };
 
-        static bool is_in_board(int x, int y) {
-            return x >= 0 && x < 8 && y >= 0 && y < 8;
-        }
+    extern template class BasicGameState<RussianRules>;
+    extern template class BasicGameState<EnglishRules>;
+    extern template class BasicGameState<InternationalRules>;
+
+    /// Stan gry w warcaby rosyjskie, w które gra program.
+    using GameState = BasicGameState<RussianRules>;
+    using EnglishGameState = BasicGameState<EnglishRules>;
+    using InternationalGameState = BasicGameState<InternationalRules>;
+
+    static_assert(std::is_trivially_copyable_v<GameState>, "GameState is copied with memcpy in the search");
+    static_assert(std::is_same_v<GameState::MoveListType, MoveList>, "the search uses MoveList for GameState moves");
+
+    /**
+     * @brief Wszystkie dozwolone ruchy obecnego gracza, wyznaczone raz dla pozycji.
+     * @details Kontroler odświeża zbiór po każdej zmianie stanu gry i odpowiada z niego na pytania
+     *          o zaznaczenie bierki i ruch gracza, a widok dostaje go razem z planszą do podświetlania
+     *          pól docelowych. Zbiór nie jest częścią GameState, bo stan gry jest kopiowany
+     *          w każdym węźle przeszukiwania.
+     */
+    class LegalMoveSet
+    {
+    public:
+        LegalMoveSet() = default;
+        /**
+         * @brief Wyznacza ruchy obecnego gracza jednym wywołaniem GameState::legal_moves.
+         */
+        explicit LegalMoveSet(const GameState &gameState);
+        /**
+         * @return Czy można wybrać to pole = czy na tym polu jest bierka, która ma możliwy ruch.
+         */
+        bool can_select_field(Coord field) const;
+        /**
+         * @return Czy ruch z pola from na pole to jest dozwolony.
+         */
+        bool can_move_piece(Coord from, Coord to) const;
+        /**
+         * @return Lista możliwych ruchów bierki stojącej na polu o podanych współrzędnych.
+         */
+        std::vector<Coord> piece_moves(Coord field) const;
+        /**
+         * @return Maska pól docelowych bierki stojącej na polu o podanych współrzędnych.
+         */
+        std::uint32_t get_targets(Coord field) const;
+        /**
+         * @return Czy dozwolone ruchy są biciami.
+         */
+        bool is_capture() const;
+
+    private:
+        /// Maska pól z bierkami, które mają możliwy ruch.
+        std::uint32_t pieces = 0;
+        /// Maski pól docelowych dla każdego pola.
+        std::uint32_t targets[SQUARES] = {};
+        /// Czy obecny gracz ma obowiązek bicia.
+        bool capture = false;
     };
 
 } // namespace checkers
@@ -0,0 +1,235 @@
+/**
+ * @file Mcts.hpp
+ * @author Bartosz Świrta
+ * @brief Zawiera deklarację klasy Mcts - przeszukiwania drzewa gry metodą Monte Carlo (UCT),
+ *        oraz puli węzłów drzewa.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "Game.hpp"
+#include "Config.hpp"
+#include "Search.hpp"
+
+namespace checkers::bot
+{
+    /// Indeks węzła w puli.
+    using NodeIndex = std::uint32_t;
+    /// Wartość oznaczająca brak węzła.
+    constexpr NodeIndex NO_NODE = UINT32_MAX;
+
+    /// Stała eksploracji we wzorze UCT.
+    constexpr double MCTS_EXPLORATION = 1.0;
+    /// Największa liczba węzłów jednego drzewa.
+    constexpr std::size_t MCTS_MAX_NODES = 1 << 21;
+    /// Liczba węzłów rezerwowanych na jedną symulację (średnio kilka ruchów na rozwinięcie).
+    constexpr std::size_t MCTS_NODES_PER_ITERATION = 12;
+    /// Rozmiar bufora na stosie wątku, z którego pochodzi ścieżka symulacji.
+    constexpr std::size_t MCTS_PATH_BYTES = 4096;
+    /// Długość symulacji losowej, po której gra uznawana jest za remis.
+    constexpr int MCTS_MAX_PLAYOUT_PLIES = 400;
+    /// Długość symulacji z heurystyką, po której wynik rozstrzyga ocena pozycji.
+    constexpr int MCTS_PLAYOUT_CUTOFF = 12;
+    /// Przewaga oceny (wartość piona), od której ucięta symulacja liczy się jako wygrana.
+    constexpr int MCTS_PLAYOUT_MARGIN = 4;
+    /// Liczba wirtualnych odwiedzin, którymi ocena heurystyczna zasila nowy węzeł.
+    constexpr int MCTS_PRIOR_VISITS = 4;
+    /// Skala oceny heurystycznej przy zamianie na prawdopodobieństwo wygranej.
+    constexpr double MCTS_PRIOR_SCALE = 4.0;
+
+    /** \struct MctsNode
+     * @brief Węzeł drzewa: ruch prowadzący do pozycji i statystyki symulacji.
+     * @details Wyniki liczone są w połówkach (wygrana 2, remis 1, porażka 0) z perspektywy gracza,
+     *          który wykonał ruch prowadzący do węzła. Liczniki są atomowe, bo w trybie
+     *          MCTS_TREE drzewo jest wspólne dla wszystkich wątków.
+     */
+    struct MctsNode
+    {
+        enum ExpansionEnum : std::uint8_t
+        {
+            LEAF,
+            EXPANDING,
+            EXPANDED
+        };
+
+        /// Ruch prowadzący do węzła.
+        Move move{0, 0};
+        /// Gracz, który wykonał ruch.
+        PlayerEnum mover = WHITE;
+        /// Pierwsze z dzieci, zajmujących ciągły blok puli.
+        NodeIndex firstChild = NO_NODE;
+        /// Liczba dzieci.
+        std::uint16_t childCount = 0;
+        /// Stan rozwinięcia węzła.
+        std::atomic<std::uint8_t> expansion{LEAF};
+        /// Liczba odwiedzin.
+        std::atomic<int> visits{0};
+        /// Suma wyników w połówkach.
+        std::atomic<int> value{0};
+        /// Liczba symulacji w toku, które przechodzą przez węzeł (wirtualne porażki).
+        std::atomic<int> virtualLoss{0};
+    };
+
+    /**
+     * @brief Pula węzłów drzewa o stałej pojemności, przydzielająca bloki bez blokad.
+     * @details Pamięć jest alokowana raz na całe przeszukiwanie, a dzieci węzła zajmują ciągły blok,
+     *          więc rozwinięcie węzła to jedna operacja atomowa zamiast alokacji na stercie.
+     */
+    class NodePool
+    {
+    public:
+        /**
+         * @brief Konstruktor puli o podanej pojemności.
+         * @param memory_ - źródło pamięci węzłów
+         */
+        NodePool(std::size_t capacity_, std::pmr::memory_resource *memory_);
+        ~NodePool();
+
+        NodePool(const NodePool &) = delete;
+        NodePool &operator=(const NodePool &) = delete;
+        /**
+         * @brief Przydziela ciągły blok węzłów.
+         * @param count - liczba węzłów
+         * @return NodeIndex - pierwszy węzeł bloku lub NO_NODE jeśli pula jest pełna
+         */
+        NodeIndex allocate(std::size_t count);
+        /**
+         * @return Liczba przydzielonych węzłów.
+         */
+        std::size_t size() const;
+
+        MctsNode &operator[](NodeIndex index) { return nodes[index]; }
+        const MctsNode &operator[](NodeIndex index) const { return nodes[index]; }
+
+    private:
+        /// Pojemność puli.
+        std::size_t capacity;
+        /// Źródło pamięci węzłów.
+        std::pmr::memory_resource *memory;
+        /// Węzły puli.
+        MctsNode *nodes;
+        /// Liczba przydzielonych węzłów.
+        std::atomic<std::size_t> used{0};
+    };
+
+    /** \struct MctsResult
+     * @brief Wynik przeszukiwania: wybrany ruch i statystyki.
+     */
+    struct MctsResult
+    {
+        /// Ruch z największą liczbą odwiedzin.
+        Move move;
+        /// Liczba odwiedzin wybranego ruchu (suma po drzewach).
+        int visits;
+        /// Średni wynik wybranego ruchu z perspektywy gracza wykonującego ruch (0 - 1).
+        double score;
+        /// Liczba wykonanych symulacji.
+        std::uint64_t iterations;
+        /// Liczba węzłów we wszystkich drzewach.
+        std::uint64_t nodes;
+    };
+
+    /**
+     * @brief Przeszukiwanie drzewa gry metodą Monte Carlo z wyborem węzłów wzorem UCT.
+     * @details W trybie MCTS_ROOT każdy wątek buduje własne drzewo, a na koniec odwiedziny ruchów
+     *          w korzeniach są sumowane. W trybie MCTS_TREE wątki dzielą jedno drzewo, a symulacje
+     *          w toku oznaczają odwiedzone węzły wirtualną porażką, żeby inne wątki wybierały inne
+     *          ścieżki. Symulacje rozgrywane są losowo do końca gry albo, z HEURISTIC_PLAYOUT,
+     *          ucinane po kilku ruchach i rozstrzygane oceną heurystyki, która służy też jako
+     *          wiedza wstępna nowych węzłów.
+     *          Pule węzłów pochodzą z obszaru pamięci zwalnianego na końcu run(), a ścieżki symulacji
+     *          z bufora na stosie każdego wątku, więc wątki nie korzystają ze sterty.
+     *          Wątek wywołujący run() czeka na wątki przeszukujące i co PROGRESS_INTERVAL raportuje
+     *          postęp, podając liczbę symulacji jako liczbę węzłów.
+     */
+    class Mcts
+    {
+    public:
+        /**
+         * @brief Konstruktor przeszukiwania.
+         * @param heuristicType_ - heurystyka używana w symulacjach HEURISTIC_PLAYOUT
+         * @param mode_ - MCTS_ROOT lub MCTS_TREE
+         * @param options_ - liczba symulacji, limit czasu, liczba wątków i rodzaj symulacji
+         * @param memory_ - źródło bloków obszaru pamięci przeszukiwania
+         */
+        Mcts(HeuristicEnum heuristicType_, SearchEnum mode_, const MctsOptions &options_,
+             std::pmr::memory_resource *memory_ = std::pmr::get_default_resource());
+        /**
+         * @brief Przeszukuje drzewo gry z podanego stanu.
+         * @param gameState - stan gry w korzeniu
+         * @return std::optional<MctsResult> - wybrany ruch lub nullopt jeśli gracz nie ma ruchów
+         */
+        std::optional<MctsResult> run(const GameState &gameState);
+        /**
+         * @brief Ustawia funkcję wywoływaną z postępem przeszukiwania, w wątku wywołującym run().
+         */
+        void set_progress_callback(std::function<void(const SearchInfo &)> callback);
+
+    private:
+        /// Heurystyka używana w symulacjach HEURISTIC_PLAYOUT.
+        HeuristicEnum heuristicType;
+        /// Rodzaj zrównoleglenia.
+        SearchEnum mode;
+        /// Ustawienia przeszukiwania.
+        MctsOptions options;
+        /// Źródło bloków obszaru pamięci przeszukiwania.
+        std::pmr::memory_resource *memory;
+        /// Liczba rozpoczętych symulacji.
+        std::atomic<std::uint64_t> started{0};
+        /// Moment, w którym przeszukiwanie musi się zakończyć.
+        std::optional<std::chrono::steady_clock::time_point> deadline;
+        /// Funkcja wywoływana z postępem przeszukiwania.
+        std::function<void(const SearchInfo &)> onProgress;
+        /// Mutex chroniący liczbę zakończonych wątków.
+        std::mutex workersMutex;
+        /// Zmienna warunkowa budząca wątek raportujący postęp po zakończeniu wątku przeszukującego.
+        std::condition_variable workersDone;
+        /// Liczba wątków przeszukujących, które zakończyły pracę.
+        int finishedWorkers = 0;
+
+        /// Wykonuje symulacje w jednym drzewie, dopóki nie wyczerpie się limit.
+        void search_tree(NodePool &pool, const GameState &root, std::mt19937 &rng, bool virtualLoss);
+        /// Jedna symulacja: wybór ścieżki, rozwinięcie liścia, rozgrywka i propagacja wyniku.
+        void iterate(NodePool &pool, const GameState &root, std::mt19937 &rng, bool virtualLoss,
+                     std::pmr::vector<NodeIndex> &path);
+        /// Rozwija węzeł, zwraca false jeśli zrobił to inny wątek lub pula jest pełna.
+        bool expand(NodePool &pool, NodeIndex index, const GameState &gameState);
+        /// Wybiera dziecko węzła wzorem UCT.
+        NodeIndex select(const NodePool &pool, NodeIndex index) const;
+        /// Rozgrywa symulację z podanego stanu, zwraca jej wynik.
+        GameProgressEnum playout(GameState gameState, std::mt19937 &rng) const;
+    };
+
+    /**
+     * @brief Zwraca ruch wybrany przez przeszukiwanie Monte Carlo.
+     * @param gameState - stan gry
+     * @param heuristicType - heurystyka używana w symulacjach HEURISTIC_PLAYOUT
+     * @param mode - MCTS_ROOT lub MCTS_TREE
+     * @param options - ustawienia przeszukiwania
+     * @param progress - opcjonalna funkcja wywoływana z postępem przeszukiwania
+     * @param memory - źródło bloków obszaru pamięci przeszukiwania, zwalnianego przed powrotem z funkcji
+     * @return std::pair<Coord, Coord> - współrzędne najlepszego ruchu (skąd dokąd)
+     */
+    std::pair<Coord, Coord> mcts_move(const GameState &gameState, HeuristicEnum heuristicType, SearchEnum mode,
+                                      const MctsOptions &options,
+                                      const std::function<void(const SearchInfo &)> &progress = nullptr,
+                                      std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+
+} // namespace checkers::bot
@@ -0,0 +1,76 @@
+/**
+ * @file Memory.hpp
+ * @author Maciej Wojno
+ * @brief Zawiera deklarację liczenia alokacji na stercie i odczytu zajętej pamięci procesu.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+namespace checkers::memory
+{
+    /** \struct AllocationCounters
+     * @brief Liczba alokacji i zaalokowanych bajtów.
+     */
+    struct AllocationCounters
+    {
+        std::uint64_t allocations = 0;
+        std::uint64_t bytes = 0;
+    };
+
+    /** \struct ResidentMemory
+     * @brief Pamięć procesu odczytana z /proc/self/status.
+     */
+    struct ResidentMemory
+    {
+        /// Obecnie zajęta pamięć fizyczna (VmRSS) w KiB.
+        std::uint64_t residentKb = 0;
+        /// Największa zajęta pamięć fizyczna od startu procesu (VmHWM) w KiB.
+        std::uint64_t peakResidentKb = 0;
+    };
+
+    /**
+     * @brief Włącza lub wyłącza liczenie alokacji przez globalny operator new.
+     * @details Gdy liczenie jest wyłączone, alokacja kosztuje tylko sprawdzenie flagi.
+     */
+    void set_counting(bool enabled);
+    /**
+     * @return Czy alokacje są liczone.
+     */
+    bool counting();
+    /**
+     * @return Liczniki alokacji obecnego wątku od jego startu.
+     */
+    AllocationCounters thread_counters();
+    /**
+     * @brief Odczytuje pamięć procesu z /proc/self/status.
+     * @return std::optional<ResidentMemory> - pamięć procesu lub nullopt jeśli plik jest niedostępny
+     */
+    std::optional<ResidentMemory> read_resident_memory();
+
+    /**
+     * @brief Liczy alokacje obecnego wątku od utworzenia obiektu.
+     * @details Liczniki są osobne dla każdego wątku, więc alokacje widoku w trakcie ruchu bota
+     *          nie są wliczane. Nie są wliczane też alokacje wątków pomocniczych (np. --mctsthreads).
+     */
+    class AllocationScope
+    {
+    public:
+        AllocationScope();
+        /**
+         * @return Liczba alokacji i bajtów od utworzenia obiektu.
+         */
+        AllocationCounters elapsed() const;
+
+    private:
+        /// Liczniki wątku w chwili utworzenia obiektu.
+        AllocationCounters begin;
+    };
+
+} // namespace checkers::memory
@@ -13,6 +13,7 @@
 
 #include <queue>
 #include <memory>
+#include <atomic>
 #include <condition_variable>
 
 #include "Game.hpp"
@@ -25,12 +26,94 @@ namespace checkers
      */
     struct GameStateMessage
     {
-        GameStateMessage(GameProgressEnum gp, BoardState bs, std::optional<Coord> sf)
-            : gameProgressEnum(gp), boardState(bs), selectedField(sf) {}
+        GameStateMessage(GameProgressEnum gp, BoardState bs, std::optional<Coord> sf, LegalMoveSet lm)
+            : gameProgressEnum(gp), boardState(bs), selectedField(sf), legalMoves(lm) {}
 
         GameProgressEnum gameProgressEnum;
         BoardState boardState;
         std::optional<Coord> selectedField;
+        /// Dozwolone ruchy obecnego gracza, do podświetlenia pól docelowych zaznaczonej bierki.
+        LegalMoveSet legalMoves;
+    };
+
+    /// Długość zapisu wariantu głównego w statystykach (razem z kończącym zerem).
+    constexpr int STATS_PV_CHARS = 96;
+    /// Liczba ostatnich czasów ruchu bota pokazywanych w statystykach.
+    constexpr int STATS_LATENCY_HISTORY = 32;
+
+    /**
+     * @brief Migawka statystyk bota, wysyłana przez kontroler do widoku w trakcie przeszukiwania.
+     * @details Struktura nie zawiera wskaźników, więc jej kopiowanie jest zwykłym kopiowaniem pamięci.
+     *
+     */
+    struct StatsMessage
+    {
+        /// Gracz, dla którego bot szuka lub ostatnio szukał ruchu.
+        PlayerEnum player = WHITE;
+        /// Czy przeszukiwanie jest w toku.
+        bool searching = false;
+        /// Głębokość obecnej iteracji.
+        int depth = 0;
+        /// Docelowa głębokość przeszukiwania (0 gdy bot nie przeszukuje na ustaloną głębokość).
+        int maxDepth = 0;
+        /// Ocena najlepszego ruchu z ukończonej iteracji, z perspektywy białych.
+        int score = 0;
+        /// Liczba odwiedzonych węzłów.
+        std::uint64_t nodes = 0;
+        /// Czas od początku przeszukiwania w milisekundach.
+        std::int64_t elapsedMs = 0;
+        /// Pozostały czas przeszukiwania w milisekundach lub -1 gdy bot nie ma limitu czasu.
+        std::int64_t remainingMs = -1;
+        /// Odsetek ocen liści znalezionych w tablicy ocen.
+        double evalHitRate = 0;
+        /// Szacowany czas zaoszczędzony dzięki tablicy ocen w milisekundach.
+        std::int64_t evalSavedMs = 0;
+        /// Wariant główny w zapisie notacji, zakończony zerem.
+        char pv[STATS_PV_CHARS] = {};
+        /// Czasy ostatnich ruchów bota w milisekundach (bufor pierścieniowy).
+        float latenciesMs[STATS_LATENCY_HISTORY] = {};
+        /// Liczba wszystkich zapisanych czasów ruchu.
+        int latencyCount = 0;
+    };
+
+    /**
+     * @brief Przekazuje najnowszą wartość od jednego piszącego do jednego czytającego bez blokad.
+     * @details Potrójny bufor: piszący i czytający mają po jednym własnym slocie, a trzeci jest
+     *          wymieniany atomowo. Czytający dostaje zawsze całą, ostatnio opublikowaną wartość,
+     *          a pośrednie wartości, których nie zdążył odczytać, są pomijane.
+     *
+     */
+    template <typename T>
+    class SnapshotExchange
+    {
+    public:
+        /// Publikuje wartość. Wywoływane tylko z wątku piszącego.
+        void publish(const T &value)
+        {
+            slots[back] = value;
+            back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX;
+        }
+        /// Odbiera ostatnio opublikowaną wartość, jeśli pojawiła się nowa. Wywoływane tylko z wątku czytającego.
+        std::optional<T> check()
+        {
+            if (!(middle.load(std::memory_order_relaxed) & FRESH)) return std::nullopt;
+            front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+            return slots[front];
+        }
+
+    private:
+        /// Bit slotu wymiany oznaczający nieodczytaną wartość.
+        static constexpr std::uint8_t FRESH = 4;
+        /// Maska numeru slotu.
+        static constexpr std::uint8_t INDEX = 3;
+
+        T slots[3];
+        /// Slot piszącego.
+        std::uint8_t back = 0;
+        /// Slot czytającego.
+        std::uint8_t front = 1;
+        /// Slot wymiany wraz z bitem FRESH.
+        std::atomic<std::uint8_t> middle{2};
     };
 
     /**
@@ -74,10 +157,16 @@ namespace checkers
         void send_player_input(const PlayerInputMessage input);
         /// Odebranie wiadomości o akcji gracza z kolejki.
         PlayerInputMessage wait_for_player_input();
+        /// Odebranie wiadomości o akcji gracza z kolejki bez czekania, jeśli nie jest pusta.
+        std::optional<PlayerInputMessage> check_for_player_input();
         /// Wysłanie nowego stanu gry do kolejki.
         void send_game_state(const GameStateMessage state);
         /// Wyciągnięcie nowego stanu gry z kolejki stanów gry jeśli nie jest pusta.
         std::optional<const GameStateMessage> check_for_game_state();
+        /// Opublikowanie statystyk bota.
+        void publish_stats(const StatsMessage &stats);
+        /// Odebranie najnowszych statystyk bota, jeśli zmieniły się od ostatniego odczytu.
+        std::optional<StatsMessage> check_for_stats();
 
     private:
         /// Kolejka z wiadomościami o akcjach gracza od widoku do kontrolera.
@@ -89,6 +178,9 @@ namespace checkers
 
         /// Kolejka z wiadmościami o stanie gry od kontorlera do widoku.
         std::queue<GameStateMessage> gameStateQueue;
+
+        /// Najnowsze statystyki bota od kontrolera do widoku.
+        SnapshotExchange<StatsMessage> stats;
     };
 
 } // namespace checkers
@@ -0,0 +1,129 @@
+/**
+ * @file Nnue.hpp
+ * @author Bartosz Świrta
+ * @brief Zawiera deklarację klasy Network - małej skwantowanej sieci neuronowej oceniającej pozycję,
+ *        z akumulatorem aktualizowanym przyrostowo po każdym ruchu.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "Game.hpp"
+
+namespace checkers::bot
+{
+    /// Liczba wejść sieci: rodzaj bierki (PieceEnum) razy pole planszy.
+    constexpr int NNUE_INPUTS = 4 * SQUARES;
+    /// Rozmiar akumulatora (pierwszej warstwy ukrytej).
+    constexpr int NNUE_HIDDEN = 64;
+    /// Rozmiar drugiej warstwy ukrytej.
+    constexpr int NNUE_HIDDEN2 = 32;
+    /// Górna granica aktywacji (clipped ReLU) w obu warstwach ukrytych.
+    constexpr int NNUE_ACTIVATION_MAX = 127;
+    /// Przesunięcie bitowe sum drugiej warstwy (wagi int8 w jednostkach 1/64).
+    constexpr int NNUE_HIDDEN2_SHIFT = 6;
+    /// Dzielnik wyjścia sieci, sprowadzający je do skali heurystyk (pion = 4).
+    constexpr int NNUE_OUTPUT_SCALE = 4;
+
+    /** \struct Accumulator
+     * @brief Sumy wag pierwszej warstwy dla aktywnych wejść, zachowywane dla każdego węzła ścieżki.
+     */
+    struct Accumulator
+    {
+        alignas(16) std::int16_t values[NNUE_HIDDEN];
+    };
+
+    /**
+     * @brief Skwantowana sieć oceniająca pozycję z perspektywy białych.
+     * @details Wejściami są pary (bierka, pole). Pierwsza warstwa (int16) jest akumulatorem: po ruchu
+     *          wystarczy odjąć wagi zniknięć i dodać wagi pojawień się bierek, zamiast liczyć ją
+     *          od nowa. Dalej clipped ReLU, warstwa gęsta int8 z clipped ReLU i wyjście int8.
+     *          Obliczenia korzystają z SSE2, jeśli procesor je udostępnia.
+     *
+     *          Plik wag (little endian): "CKNN", uint32 wersja (1), uint32 NNUE_INPUTS, NNUE_HIDDEN,
+     *          NNUE_HIDDEN2, potem int16 featureWeights[NNUE_INPUTS][NNUE_HIDDEN],
+     *          int16 featureBias[NNUE_HIDDEN], int8 hiddenWeights[NNUE_HIDDEN2][NNUE_HIDDEN],
+     *          int32 hiddenBias[NNUE_HIDDEN2], int8 outputWeights[NNUE_HIDDEN2], int32 outputBias.
+     */
+    class Network
+    {
+    public:
+        /**
+         * @brief Wczytuje wagi sieci z pliku.
+         * @param path - ścieżka do pliku wag
+         * @return std::optional<Network> - sieć lub nullopt jeśli pliku nie da się odczytać lub ma zły format
+         */
+        static std::optional<Network> try_load(const std::string &path);
+        /**
+         * @brief Sieć startowa, odtwarzająca dokładnie heurystykę BOARD_AWARE.
+         * @details Każde pole ma własny neuron białych i czarnych, więc sieć jest punktem wyjścia
+         *          do uczenia i wzorcem formatu pliku wag.
+         */
+        static Network bootstrap();
+        /**
+         * @brief Zapisuje wagi sieci do pliku.
+         * @param path - ścieżka do pliku wag
+         * @return Czy udało się zapisać plik.
+         */
+        bool save(const std::string &path) const;
+        /**
+         * @brief Liczy akumulator od nowa dla podanego stanu.
+         */
+        void refresh(const GameState &gameState, Accumulator &accumulator) const;
+        /**
+         * @brief Liczy akumulator stanu po ruchu z akumulatora stanu przed ruchem.
+         * @param parent - akumulator stanu przed ruchem
+         * @param child - akumulator uzupełniany dla stanu po ruchu
+         * @param before - stan przed ruchem
+         * @param after - stan po ruchu
+         */
+        void update(const Accumulator &parent, Accumulator &child, const GameState &before, const GameState &after) const;
+        /**
+         * @return Ocena pozycji o podanym akumulatorze, w skali heurystyk.
+         */
+        int evaluate(const Accumulator &accumulator) const;
+        /**
+         * @return Ocena pozycji liczona bez akumulatora z poprzedniego stanu.
+         */
+        int evaluate(const GameState &gameState) const;
+        /**
+         * @return Górne oszacowanie zmiany oceny po jednym cichym ruchu bez przemiany (margines futility pruning).
+         */
+        int positional_margin() const;
+
+    private:
+        alignas(16) std::int16_t featureWeights[NNUE_INPUTS][NNUE_HIDDEN];
+        alignas(16) std::int16_t featureBias[NNUE_HIDDEN];
+        alignas(16) std::int8_t hiddenWeights[NNUE_HIDDEN2][NNUE_HIDDEN];
+        std::int32_t hiddenBias[NNUE_HIDDEN2];
+        std::int8_t outputWeights[NNUE_HIDDEN2];
+        std::int32_t outputBias;
+        /// Margines futility pruning, liczony z wag przy wczytaniu sieci.
+        int positionalMargin;
+
+        /// Dodaje (sign = 1) lub odejmuje (sign = -1) wagi wejścia od akumulatora.
+        void apply_feature(Accumulator &accumulator, int feature, int sign) const;
+        /// Ogranicza zysk właściciela bierki po cichym ruchu, przenosząc przedziały zmian przez kolejne
+        /// warstwy (clipped ReLU nie zwiększa różnic), i bierze największy po wszystkich ruchach bierek.
+        int compute_positional_margin() const;
+    };
+
+    /**
+     * @brief Ustawia sieć używaną przez heurystykę NNUE. Wywoływane przed uruchomieniem botów.
+     */
+    void set_network(std::unique_ptr<Network> network);
+    /**
+     * @return Sieć wczytana przez set_network, a jeśli jej nie ustawiono - sieć startowa.
+     */
+    const Network &active_network();
+
+} // namespace checkers::bot
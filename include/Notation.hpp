@@ -0,0 +1,46 @@
+/**
+ * @file Notation.hpp
+ * @author Maciej Wojno
+ * @brief Zawiera funkcje zamieniające pola i ruchy na zapis tekstowy (np. "c3-d4", "c3:e5") i z powrotem.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#pragma once
+
+#include <optional>
+#include <string>
+
+#include "Game.hpp"
+
+namespace checkers
+{
+    /**
+     * @brief Zapis pola w notacji szachowej, kolumny a-h (x) i rzędy 1-8 (y).
+     * @param square - indeks pola
+     * @return std::string - np. "c3"
+     */
+    std::string square_to_string(Square square);
+    /**
+     * @brief Odczytuje pole zapisane w notacji szachowej.
+     * @param text - np. "c3"
+     * @return std::optional<Square> - indeks pola lub nullopt jeśli zapis nie wskazuje grywalnego pola
+     */
+    std::optional<Square> square_from_string(const std::string &text);
+    /**
+     * @brief Zapis ruchu. Bicia oddzielane są dwukropkiem, pozostałe ruchy myślnikiem.
+     * @param gameState - stan gry przed wykonaniem ruchu
+     * @param move - zapisywany ruch
+     * @return std::string - np. "c3-d4" lub "c3:e5"
+     */
+    std::string move_to_string(const GameState &gameState, Move move);
+    /**
+     * @brief Odczytuje ruch zapisany jako dwa pola oddzielone myślnikiem lub dwukropkiem.
+     * @param text - np. "c3-d4"
+     * @return std::optional<Move> - ruch lub nullopt jeśli zapis jest niepoprawny
+     */
+    std::optional<Move> move_from_string(const std::string &text);
+
+} // namespace checkers
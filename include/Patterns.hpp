@@ -0,0 +1,117 @@
+/**
+ * @file Patterns.hpp
+ * @author Bartosz Świrta
+ * @brief Zawiera deklarację klasy PatternTables - oceny pozycji tablicami wzorców indeksowanymi
+ *        lokalnymi układami bierek, generowanymi zawczasu i mapowanymi z pliku przy starcie.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Game.hpp"
+
+namespace checkers::bot
+{
+    /// Liczba układów pola i jego czterech sąsiadów po przekątnych (po 2 bity na pole).
+    constexpr int PATTERN_NEIGHBOURHOODS = 1 << (2 * (DIRECTIONS + 1));
+    /// Liczba rzędów planszy.
+    constexpr int PATTERN_ROWS = Board8::BOARD_SIZE;
+    /// Liczba układów pionów obu graczy w rzędzie (po 4 bity na gracza).
+    constexpr int PATTERN_ROW_CONFIGS = 1 << (2 * (Board8::BOARD_SIZE / 2));
+    /// Kara za bierkę, którą przeciwnik może zbić z sąsiedniego pola.
+    constexpr int PATTERN_HANGING = 2;
+    /// Premia za piona o jeden ruch od promocji z wolnym polem przed sobą.
+    constexpr int PATTERN_RUNAWAY = 3;
+    /// Górne oszacowanie zysku pozycyjnego jednego ruchu bez bicia (margines futility pruning).
+    constexpr int PATTERN_POSITIONAL_MAX = 8;
+
+    /** \struct PatternData
+     * @brief Tablice wzorców w takim układzie, w jakim leżą w pliku.
+     * @details Wartości są z perspektywy białych, w skali heurystyk (pion = 4), i zawierają
+     *          wartość materialną bierek, więc ocena pozycji to tylko suma odczytów z tablic.
+     */
+    struct PatternData
+    {
+        /// Ocena bierki na danym polu w danym układzie sąsiedztwa. Bity 0-1 indeksu to bierka na polu
+        /// (PieceEnum), bity 2d-2d+1 to sąsiad w kierunku d: 0 puste, 1 biała, 2 czarna, 3 poza planszą.
+        std::int8_t neighbourhoods[SQUARES][PATTERN_NEIGHBOURHOODS];
+        /// Ocena pionów w danym rzędzie. Bity 0-3 indeksu to piony białych, bity 4-7 piony czarnych.
+        std::int8_t rows[PATTERN_ROWS][PATTERN_ROW_CONFIGS];
+    };
+
+    /**
+     * @brief Ocena pozycji tablicami wzorców.
+     * @details Dla każdej bierki odczytywana jest ocena układu jej pola i czterech sąsiednich,
+     *          a dla każdego rzędu ocena układu pionów w rzędzie. Wzorce opisują bierki zablokowane
+     *          i zagrożone biciem, piony wspierane od tyłu, piony przed promocją oraz obsadę
+     *          pól ostatniego rzędu, które chronią go przed wejściem pionów przeciwnika.
+     *
+     *          Tablice generuje generate(), a save() zapisuje je do pliku, który przy starcie
+     *          programu mapowany jest do pamięci tylko do odczytu (try_map), więc nie trzeba
+     *          ich liczyć ani kopiować. Plik (little endian): "CKPT", uint32 wersja (1),
+     *          uint32 SQUARES, PATTERN_NEIGHBOURHOODS, PATTERN_ROWS, PATTERN_ROW_CONFIGS,
+     *          potem PatternData.
+     */
+    class PatternTables
+    {
+    public:
+        PatternTables(const PatternTables &) = delete;
+        PatternTables &operator=(const PatternTables &) = delete;
+        ~PatternTables();
+
+        /**
+         * @brief Mapuje tablice z pliku do pamięci (na systemach bez mmap wczytuje je).
+         * @param path - ścieżka do pliku tablic
+         * @return std::unique_ptr<PatternTables> - tablice lub nullptr jeśli pliku nie da się odczytać lub ma zły format
+         */
+        static std::unique_ptr<PatternTables> try_map(const std::string &path);
+        /**
+         * @brief Generuje tablice z ręcznie dobranych reguł oceny wzorców.
+         */
+        static std::unique_ptr<PatternTables> generate();
+        /**
+         * @brief Zapisuje tablice do pliku.
+         * @param path - ścieżka do pliku tablic
+         * @return Czy udało się zapisać plik.
+         */
+        bool save(const std::string &path) const;
+        /**
+         * @return Ocena pozycji z perspektywy białych, w skali heurystyk.
+         */
+        int evaluate(const GameState &gameState) const;
+
+    private:
+        PatternTables() = default;
+
+        /// Obraz pliku: nagłówek i tablice.
+        const char *image = nullptr;
+        /// Tablice wewnątrz obrazu pliku.
+        const PatternData *data = nullptr;
+        /// Obraz pliku wygenerowany lub wczytany do pamięci (pusty, jeśli plik jest zmapowany).
+        std::vector<char> storage;
+        /// Czy obraz pliku jest zmapowany i trzeba go zwolnić w destruktorze.
+        bool mapped = false;
+
+        /// Sprawdza nagłówek obrazu pliku i ustawia wskaźnik na tablice.
+        bool attach(const char *fileImage);
+    };
+
+    /**
+     * @brief Ustawia tablice używane przez heurystykę PATTERN. Wywoływane przed uruchomieniem botów.
+     */
+    void set_pattern_tables(std::unique_ptr<PatternTables> tables);
+    /**
+     * @return Tablice ustawione przez set_pattern_tables, a jeśli ich nie ustawiono - wygenerowane.
+     */
+    const PatternTables &active_pattern_tables();
+
+} // namespace checkers::bot
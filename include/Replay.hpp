@@ -0,0 +1,139 @@
+/**
+ * @file Replay.hpp
+ * @author Maciej Wojno
+ * @brief Zawiera deklarację klasy Replay - sprawdzania zapisanych partii przez odtworzenie ich ruchów,
+ *        które służy też jako pomiar wydajności reguł gry.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Game.hpp"
+#include "Config.hpp"
+
+namespace checkers
+{
+    /// Liczba partii przekazywanych naraz od wątku czytającego plik do wątków sprawdzających.
+    constexpr std::size_t REPLAY_BATCH_SIZE = 64;
+    /// Największa liczba paczek partii oczekujących na sprawdzenie.
+    constexpr std::size_t REPLAY_QUEUE_BATCHES = 64;
+
+    /** \struct RecordedGame
+     * @brief Partia odczytana z pliku, przed odtworzeniem.
+     */
+    struct RecordedGame
+    {
+        /// Plik, z którego pochodzi partia.
+        std::string source;
+        /// Linia pliku, w której zaczyna się partia.
+        int line = 0;
+        /// Pozycja początkowa w zapisie z pliku (pusty - pozycja startowa).
+        std::string position;
+        /// Ruchy w kolejności z pliku, każdy jako tekst wraz z linią pliku.
+        std::vector<std::pair<std::string, int>> moves;
+        /// Zapisany wynik (pusty - wynik nieznany).
+        std::string result;
+    };
+
+    /**
+     * @brief Odczytuje partie z pliku jedna po drugiej, bez wczytywania całego pliku.
+     * @details Rozpoznaje dwa formaty: log rozgrywki (--log, jedna partia na plik, pierwsza linia
+     *          "white_param") oraz zapis podobny do PDN: znaczniki [Nazwa "wartość"], numery ruchów,
+     *          komentarze {...}, warianty (...), ruchy i wynik 1-0, 0-1, 1/2-1/2 lub *.
+     */
+    class RecordReader
+    {
+    public:
+        /**
+         * @param input_ - strumień pliku
+         * @param source_ - nazwa pliku używana w komunikatach
+         */
+        RecordReader(std::istream &input_, std::string source_);
+        /**
+         * @return std::optional<RecordedGame> - kolejna partia lub nullopt na końcu pliku
+         */
+        std::optional<RecordedGame> next();
+
+    private:
+        std::istream &input;
+        std::string source;
+        /// Numer ostatnio przeczytanej linii.
+        int lineNumber = 0;
+        /// Czy plik jest logiem rozgrywki.
+        bool log = false;
+        /// Nieprzetworzona reszta ostatnio przeczytanej linii.
+        std::string pending;
+
+        std::optional<RecordedGame> next_log();
+        std::optional<RecordedGame> next_pdn();
+        /// Czyta kolejną linię do pending, zwraca false na końcu pliku.
+        bool read_line();
+    };
+
+    /**
+     * @brief Odtwarza partię ruch po ruchu metodą GameState::try_make_move.
+     * @details Ruch to ciąg pól oddzielonych '-', 'x' lub ':' (np. "c3-d4", "c3:e5:g7", "9-13",
+     *          "22x15"). Pola zapisywane są w notacji szachowej albo numerami 1-32 jak w PDN
+     *          (od lewego górnego pola, rzędami od strony czarnych). Pominięte pola pośrednie bicia
+     *          wielokrotnego są odnajdywane (zapis pasujący do kilku bić jest błędem). Ruch musi kończyć turę gracza, a wynik zapisany
+     *          w partii musi zgadzać się z końcem gry (partia może kończyć się wcześniej poddaniem).
+     *
+     * @param game - odtwarzana partia
+     * @param moves - zwiększane o liczbę odtworzonych ruchów
+     * @return std::optional<std::string> - opis pierwszego błędu lub nullopt jeśli partia jest poprawna
+     */
+    std::optional<std::string> replay_game(const RecordedGame &game, std::uint64_t &moves);
+
+    /**
+     * @brief Sprawdza wszystkie partie z podanych plików i wypisuje błędy oraz liczbę partii na sekundę.
+     * @details Pliki czytane są równolegle (jeden wątek na plik), a paczki partii trafiają
+     *          przez ograniczoną kolejkę do wątków sprawdzających, więc pamięć nie zależy
+     *          od rozmiaru plików.
+     */
+    class Replay
+    {
+    public:
+        /**
+         * @brief Konstruktor z podaną konfiguracją.
+         *
+         */
+        explicit Replay(const Config &config_);
+        /**
+         * @brief Sprawdza partie z plików config.replayPaths.
+         *
+         * @return Czy wszystkie pliki dało się odczytać i wszystkie partie są poprawne.
+         */
+        bool run();
+
+    private:
+        /// Konfiguracja z listą plików i liczbą wątków.
+        Config config;
+
+        std::mutex queueMutex;
+        std::condition_variable queueChanged;
+        /// Paczki partii oczekujące na sprawdzenie.
+        std::deque<std::vector<RecordedGame>> queue;
+        /// Liczba wątków, które jeszcze czytają pliki.
+        int activeReaders = 0;
+
+        /// Wstawia paczkę do kolejki, czekając na miejsce.
+        void push(std::vector<RecordedGame> batch);
+        /// Pobiera paczkę z kolejki, nullopt gdy kolejka jest pusta i pliki są przeczytane.
+        std::optional<std::vector<RecordedGame>> pop();
+        /// Zgłasza koniec pracy wątku czytającego.
+        void reader_done();
+    };
+
+} // namespace checkers
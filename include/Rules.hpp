@@ -0,0 +1,92 @@
+/**
+ * @file Rules.hpp
+ * @author Maciej Wojno
+ * @brief Zawiera zestawy reguł wariantów warcabów, którymi parametryzowany jest stan gry.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#pragma once
+
+#include "Squares.hpp"
+
+namespace checkers
+{
+    /** \enum PromotionEnum
+     * @brief Moment, w którym pion staje się królową.
+     *
+     */
+    enum PromotionEnum
+    {
+        /// Od razu po wejściu na ostatni rząd, łańcuch bić jest kontynuowany już królową.
+        PROMOTE_AND_CONTINUE,
+        /// Po wejściu na ostatni rząd, co kończy turę nawet w trakcie łańcucha bić.
+        PROMOTE_AND_STOP,
+        /// Tylko jeśli tura kończy się na ostatnim rzędzie (przejście przez niego w trakcie bić się nie liczy).
+        PROMOTE_AT_TURN_END
+    };
+
+    /** \struct RussianRules
+     * @brief Warcaby rosyjskie 8x8: piony biją do tyłu, królowe ruszają się o dowolną liczbę pól,
+     *        bicie nie musi być najdłuższe.
+     */
+    struct RussianRules
+    {
+        using Board = Geometry<8>;
+        /// Liczba rzędów zajętych przez piony każdego gracza na początku gry.
+        static constexpr int PAWN_ROWS = 3;
+        /// Czy grę zaczyna biały (dolny) gracz.
+        static constexpr bool WHITE_STARTS = true;
+        /// Czy królowe ruszają się i biją na dowolną odległość.
+        static constexpr bool FLYING_QUEENS = true;
+        /// Czy piony mogą bić do tyłu.
+        static constexpr bool PAWNS_CAPTURE_BACKWARDS = true;
+        /// Czy obowiązuje bicie największej liczby bierek.
+        static constexpr bool MAXIMUM_CAPTURE = false;
+        /// Czy zbite bierki zdejmowane są dopiero po zakończeniu łańcucha bić (do tego czasu blokują pola).
+        static constexpr bool REMOVE_CAPTURED_AT_END = false;
+        static constexpr PromotionEnum PROMOTION = PROMOTE_AND_CONTINUE;
+        /// Liczba tur królowymi bez bicia, po której następuje remis.
+        static constexpr int QUEEN_MOVES_TIE = 30;
+    };
+
+    /** \struct EnglishRules
+     * @brief Warcaby angielskie (checkers) 8x8: piony biją tylko do przodu, królowe ruszają się
+     *        o jedno pole, grę zaczyna czarny, a wejście na ostatni rząd kończy turę.
+     */
+    struct EnglishRules
+    {
+        using Board = Geometry<8>;
+        static constexpr int PAWN_ROWS = 3;
+        static constexpr bool WHITE_STARTS = false;
+        static constexpr bool FLYING_QUEENS = false;
+        static constexpr bool PAWNS_CAPTURE_BACKWARDS = false;
+        static constexpr bool MAXIMUM_CAPTURE = false;
+        static constexpr bool REMOVE_CAPTURED_AT_END = false;
+        static constexpr PromotionEnum PROMOTION = PROMOTE_AND_STOP;
+        /// 40 ruchów każdego gracza.
+        static constexpr int QUEEN_MOVES_TIE = 80;
+    };
+
+    /** \struct InternationalRules
+     * @brief Warcaby międzynarodowe 10x10: obowiązuje bicie największej liczby bierek, zbite bierki
+     *        schodzą z planszy po zakończeniu bicia, a pion zostaje królową tylko kończąc turę
+     *        na ostatnim rzędzie.
+     */
+    struct InternationalRules
+    {
+        using Board = Geometry<10>;
+        static constexpr int PAWN_ROWS = 4;
+        static constexpr bool WHITE_STARTS = true;
+        static constexpr bool FLYING_QUEENS = true;
+        static constexpr bool PAWNS_CAPTURE_BACKWARDS = true;
+        static constexpr bool MAXIMUM_CAPTURE = true;
+        static constexpr bool REMOVE_CAPTURED_AT_END = true;
+        static constexpr PromotionEnum PROMOTION = PROMOTE_AT_TURN_END;
+        /// 25 ruchów każdego gracza.
+        static constexpr int QUEEN_MOVES_TIE = 50;
+    };
+
+} // namespace checkers
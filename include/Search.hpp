@@ -0,0 +1,360 @@
+/**
+ * @file Search.hpp
+ * @author Bartosz Świrta
+ * @brief Zawiera deklarację klasy Search - przeszukiwania drzewa gry z pogłębianiem iteracyjnym
+ *        i oknami multi-PV, oraz struktur opisujących limity i wyniki przeszukiwania.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+#include "Game.hpp"
+#include "Config.hpp"
+#include "EvalCache.hpp"
+#include "Nnue.hpp"
+
+namespace checkers::bot
+{
+    /// Największa obsługiwana głębokość przeszukiwania.
+    constexpr int MAX_PLY = 64;
+
+    /** \struct PrincipalVariation
+     * @brief Wariant główny budowany w trakcie przeszukiwania, bez alokacji na stercie.
+     */
+    struct PrincipalVariation
+    {
+        Move moves[MAX_PLY];
+        int length = 0;
+    };
+
+    /** \struct SearchLimits
+     * @brief Ograniczenia przeszukiwania.
+     */
+    struct SearchLimits
+    {
+        /// Maksymalna głębokość przeszukiwania.
+        int depth = 1;
+        /// Liczba najlepszych ruchów, dla których wyznaczana jest dokładna ocena.
+        int multiPv = 1;
+        /// Opcjonalny limit odwiedzonych węzłów. Pierwsza iteracja jest zawsze dokończona.
+        std::optional<std::uint64_t> nodes = std::nullopt;
+        /// Opcjonalny limit czasu przeszukiwania.
+        std::optional<std::chrono::milliseconds> time = std::nullopt;
+        /// Opcjonalna flaga ustawiana z innego wątku, żeby przerwać przeszukiwanie.
+        const std::atomic<bool> *stop = nullptr;
+        /// Włączone techniki przeszukiwania selektywnego.
+        SearchFeatures features = SearchFeatures();
+    };
+
+    /** \struct RootMove
+     * @brief Ruch z korzenia drzewa gry wraz z oceną i wariantem głównym.
+     */
+    struct RootMove
+    {
+        /// Ruch w korzeniu.
+        Move move;
+        /// Dokładna ocena ruchu z perspektywy białych (jak w estimate_move).
+        int score;
+        /// Głębokość ukończonej iteracji, w której wyznaczono ocenę.
+        int depth;
+        /// Wariant główny zaczynający się od move.
+        std::vector<Move> pv;
+    };
+
+    /** \struct SearchInfo
+     * @brief Podsumowanie ukończonej iteracji przeszukiwania.
+     */
+    struct SearchInfo
+    {
+        /// Głębokość ukończonej iteracji (w raportach postępu - iteracji w toku).
+        int depth;
+        /// Liczba węzłów odwiedzonych od początku przeszukiwania.
+        std::uint64_t nodes;
+        /// Czas od początku przeszukiwania.
+        std::chrono::microseconds time;
+        /// Najlepsze ruchy wyznaczone w tej iteracji (w raportach postępu - w ostatniej ukończonej).
+        std::vector<RootMove> lines;
+        /// Trafienia w tablicy ocen od początku przeszukiwania.
+        EvalCacheStats evalCache;
+    };
+
+    /// Granica okna przeszukiwania. Symetryczna, więc okno można odwrócić w negamax bez przepełnienia.
+    constexpr int SCORE_INFINITY = INT_MAX;
+    /// Odstęp między kolejnymi raportami postępu przeszukiwania.
+    constexpr std::chrono::milliseconds PROGRESS_INTERVAL{250};
+    /// Minimalna głębokość węzła, w którym redukowane są późne ruchy.
+    constexpr int LMR_MIN_DEPTH = 3;
+    /// Liczba pierwszych ruchów węzła przeszukiwanych zawsze na pełnej głębokości.
+    constexpr int LMR_FULL_MOVES = 3;
+    /// Największa pozostała głębokość, na której stosowane jest odcinanie ruchów bez szans.
+    constexpr int FUTILITY_MAX_DEPTH = 2;
+    /// Rozmiar pierwszego bloku pamięci przeszukiwania (listy ruchów korzenia, akumulatory sieci).
+    constexpr std::size_t SEARCH_ARENA_BYTES = 64 * 1024;
+
+    /**
+     * @brief Przeszukiwanie drzewa gry algorytmem minimax z przycinaniem alpha-beta (w postaci negamax).
+     * @details Głębokość zwiększana jest iteracyjnie, a ruchy w korzeniu porządkowane według
+     *          wyników poprzedniej iteracji. Ruchy spoza K najlepszych przeszukiwane są z oknem
+     *          ograniczonym oceną K-tego ruchu, więc koszt analizy multi-PV jest zbliżony do
+     *          zwykłego przeszukiwania. Opcjonalnie (SearchFeatures) przeszukiwanie jest selektywne:
+     *          późne ciche ruchy przeszukiwane są płycej i powtarzane na pełnej głębokości tylko
+     *          jeśli poprawiają wynik, ciche ruchy bez szans na poprawę wyniku są pomijane tuż przed
+     *          liśćmi, a wymuszone pojedyncze bicia nie zmniejszają głębokości.
+     *          Pozycja powtórzona na ścieżce oceniana jest od razu jako remis, bo ta sama
+     *          sekwencja ruchów może ją powtarzać aż do remisu z reguły trzykrotnego powtórzenia.
+     *          Oceny liści zapamiętywane są w tablicy ocen (EvalCache), bo te same pozycje
+     *          osiągane są różnymi kolejnościami ruchów i w kolejnych iteracjach.
+     *          Dane przeszukiwania pochodzą z obszaru pamięci (std::pmr::monotonic_buffer_resource)
+     *          tworzonego przez start() i zwalnianego w całości na końcu run(), przy kolejnym start()
+     *          lub zniszczeniu obiektu. Na stercie alokowane są tylko zwracane wyniki i raporty.
+     *
+     *          Przeszukiwanie jest maszyną stanów: start() przygotowuje korzeń, a step() przeszukuje
+     *          kolejne ruchy korzenia, aż minie podany czas, i wraca, więc wywołujący może w jednym
+     *          wątku przeplatać przeszukiwanie z inną pracą albo wieloma przeszukiwaniami. Krok
+     *          kończy się po ruchu korzenia, w trakcie którego minął czas, więc jego długość zależy
+     *          od rozmiaru poddrzewa jednego ruchu. run() to start() i step() bez limitu czasu.
+     */
+    class Search
+    {
+    public:
+        /**
+         * @brief Konstruktor przeszukiwania posługującego się podaną heurystyką.
+         * @param memory_ - źródło bloków pamięci dla obszaru każdego przeszukiwania
+         */
+        explicit Search(HeuristicEnum heuristicType_,
+                        std::pmr::memory_resource *memory_ = std::pmr::get_default_resource());
+        /**
+         * @brief Przeszukuje drzewo gry z podanego stanu.
+         * @param gameState - stan gry w korzeniu
+         * @param limits - ograniczenia przeszukiwania
+         * @return - do limits.multiPv najlepszych ruchów, od najlepszego dla gracza wykonującego ruch
+         */
+        std::vector<RootMove> run(const GameState &gameState, const SearchLimits &limits);
+        /**
+         * @brief Rozpoczyna przeszukiwanie wykonywane kolejnymi wywołaniami step().
+         * @param gameState - stan gry w korzeniu
+         * @param limits - ograniczenia przeszukiwania
+         */
+        void start(const GameState &gameState, const SearchLimits &limits);
+        /**
+         * @brief Kontynuuje przeszukiwanie, aż minie podany czas lub przeszukiwanie się zakończy.
+         * @param slice - czas kroku, sprawdzany po każdym ruchu korzenia (co najmniej jeden ruch na krok)
+         * @return Czy przeszukiwanie się zakończyło.
+         */
+        bool step(std::chrono::steady_clock::duration slice);
+        /**
+         * @brief Kończy przeszukiwanie przed osiągnięciem limitów. Dotychczasowy wynik pozostaje dostępny.
+         */
+        void stop();
+        /**
+         * @return Czy przeszukiwanie się zakończyło (lub nie zostało rozpoczęte).
+         */
+        bool is_finished() const;
+        /**
+         * @brief Najlepsze dotychczas ruchy: z ostatniej ukończonej iteracji, a przed jej ukończeniem
+         *        ruchy już przeszukane w pierwszej iteracji.
+         * @return - do limits.multiPv ruchów, od najlepszego dla gracza wykonującego ruch
+         */
+        std::vector<RootMove> get_best() const;
+        /**
+         * @return Stan przeszukiwania: głębokość iteracji w toku, węzły, czas i najlepsze dotychczas ruchy.
+         */
+        SearchInfo get_info() const;
+        /**
+         * @return Liczba węzłów odwiedzonych w ostatnim przeszukiwaniu.
+         */
+        std::uint64_t get_nodes() const;
+        /**
+         * @return Statystyki tablicy ocen w ostatnim przeszukiwaniu.
+         */
+        EvalCacheStats get_eval_cache_stats() const;
+        /**
+         * @brief Ustawia tablicę ocen liści (domyślnie shared_eval_cache(), nullptr - bez tablicy).
+         */
+        void set_eval_cache(EvalCache *cache);
+        /**
+         * @brief Ustawia funkcję wywoływaną po każdej ukończonej iteracji.
+         */
+        void set_iteration_callback(std::function<void(const SearchInfo &)> callback);
+        /**
+         * @brief Ustawia funkcję wywoływaną co PROGRESS_INTERVAL w trakcie przeszukiwania.
+         */
+        void set_progress_callback(std::function<void(const SearchInfo &)> callback);
+
+    private:
+        /** \struct RootLine
+         * @brief Ruch z korzenia w trakcie przeszukiwania, z wariantem głównym bez alokacji.
+         */
+        struct RootLine
+        {
+            Move move;
+            int score;
+            int depth;
+            PrincipalVariation pv;
+        };
+        /// Lista ruchów korzenia w obszarze pamięci przeszukiwania.
+        using RootLines = std::pmr::vector<RootLine>;
+
+        /** \struct RootState
+         * @brief Stan przeszukiwania zachowywany pomiędzy krokami.
+         */
+        struct RootState
+        {
+            explicit RootState(std::pmr::memory_resource *memory);
+
+            /// Obszar pamięci przeszukiwania.
+            std::pmr::monotonic_buffer_resource arena;
+            /// Stan gry w korzeniu.
+            GameState root;
+            /// Ruchy korzenia w kolejności przeszukiwania w obecnej iteracji.
+            RootLines rootMoves;
+            /// Najlepsze ruchy ostatniej ukończonej iteracji.
+            RootLines best;
+            /// K najlepszych ruchów obecnej iteracji, od najlepszego.
+            RootLines top;
+            /// Pozostałe ruchy obecnej iteracji, w kolejności przeszukiwania.
+            RootLines rest;
+            /// Czy ruch wykonuje gracz biały.
+            bool white = true;
+            /// Liczba ruchów z dokładną oceną.
+            int multiPv = 1;
+            /// Głębokość ostatniej iteracji.
+            int maxDepth = 1;
+            /// Głębokość obecnej iteracji.
+            int depth = 1;
+            /// Indeks kolejnego ruchu korzenia do przeszukania w obecnej iteracji.
+            std::size_t next = 0;
+            /// Czy przeszukiwanie się zakończyło.
+            bool finished = false;
+        };
+
+        /// Heurystyka oceniająca liście drzewa.
+        HeuristicEnum heuristicType;
+        /// Źródło bloków pamięci dla obszaru przeszukiwania.
+        std::pmr::memory_resource *memory;
+        /// Limit węzłów obowiązujący w obecnym przeszukiwaniu.
+        std::optional<std::uint64_t> nodeLimit;
+        /// Liczba odwiedzonych węzłów.
+        std::uint64_t nodes = 0;
+        /// Moment rozpoczęcia obecnego przeszukiwania.
+        std::chrono::steady_clock::time_point startTime;
+        /// Moment, w którym przeszukiwanie musi się zakończyć.
+        std::optional<std::chrono::steady_clock::time_point> deadline;
+        /// Zewnętrzna flaga przerwania przeszukiwania.
+        const std::atomic<bool> *stopSignal = nullptr;
+        /// Funkcja wywoływana po każdej ukończonej iteracji.
+        std::function<void(const SearchInfo &)> onIteration;
+        /// Funkcja wywoływana co PROGRESS_INTERVAL.
+        std::function<void(const SearchInfo &)> onProgress;
+        /// Moment ostatniego raportu postępu.
+        std::chrono::steady_clock::time_point lastProgress;
+        /// Głębokość iteracji w toku.
+        int currentDepth = 0;
+        /// Stan obecnego przeszukiwania (nullopt przed pierwszym start()).
+        std::optional<RootState> state;
+        /// Techniki przeszukiwania selektywnego używane w obecnym przeszukiwaniu.
+        SearchFeatures features;
+        /// Tablica ocen liści lub nullptr.
+        EvalCache *evalCache = &shared_eval_cache();
+        /// Liczba zapytań i trafień w tablicy ocen w obecnym przeszukiwaniu.
+        EvalCacheStats evalStats;
+        /// Łączny czas mierzonych ocen spoza tablicy (co EVAL_TIMING_INTERVAL-ta).
+        std::chrono::steady_clock::duration evalSampleTime{0};
+        /// Liczba mierzonych ocen spoza tablicy.
+        std::uint64_t evalSamples = 0;
+        /// Sieć oceniająca liście, jeśli heurystyką jest NNUE.
+        const Network *network = nullptr;
+        /// Akumulatory sieci dla kolejnych węzłów ścieżki, indeksowane odległością od korzenia
+        /// (w obszarze pamięci przeszukiwania, tylko w trakcie run).
+        Accumulator *accumulators = nullptr;
+        /// Odciski pozycji na obecnej ścieżce, indeksowane odległością od korzenia.
+        std::uint32_t pathFingerprints[MAX_PLY + 1];
+        /// Czy limit może przerwać przeszukiwanie (po ukończeniu pierwszej iteracji).
+        bool canStop = false;
+        /// Czy przeszukiwanie zostało przerwane.
+        bool stopped = false;
+
+        /**
+         * @brief Implementuje algorytm minimax z przycinaniem alpha-beta w postaci negamax.
+         * @param gameState - rozpatrywany stan gry
+         * @param depth - głębokość przeszukiwania
+         * @param ply - odległość od korzenia
+         * @param alpha - wartość zmiennej alfa (alpha-beta pruning) z perspektywy gracza wykonującego ruch
+         * @param beta - wartość zmiennej beta (alpha-beta pruning) z perspektywy gracza wykonującego ruch
+         * @param pv - wariant główny wyznaczony dla tego stanu
+         * @return - jakość danego stanu z perspektywy gracza wykonującego ruch
+         */
+        int negamax(const GameState &gameState, int depth, int ply, int alpha, int beta, PrincipalVariation &pv);
+        /**
+         * @brief Ocena stanu po ruchu z perspektywy gracza, który go wykonał.
+         * @param sameMover - czy w stanie po ruchu ruch ma ten sam gracz (łańcuch bić) - wtedy okno
+         *                    i ocena nie są odwracane
+         */
+        int child_score(const GameState &child, bool sameMover, int depth, int ply, int alpha, int beta,
+                        PrincipalVariation &pv);
+        /**
+         * @brief Zapas oceny przy odcinaniu ruchów bez szans: największy zysk pozycyjny jednego
+         *        cichego ruchu dla używanej heurystyki i wartość piona na każdy dalszy poziom.
+         * @param depth - pozostała głębokość przeszukiwania
+         */
+        int futility_margin(int depth) const;
+        /**
+         * @brief Ocenia stan heurystyką przeszukiwania, korzystając z tablicy ocen.
+         * @param gameState - oceniany stan gry
+         * @param ply - odległość stanu od korzenia
+         */
+        int evaluate(const GameState &gameState, int ply);
+        /**
+         * @brief Liczy ocenę stanu heurystyką przeszukiwania; sieć NNUE korzysta z akumulatora węzła.
+         */
+        int compute_evaluation(const GameState &gameState, int ply) const;
+        /**
+         * @brief Sprawdza czy pozycja powtarza się na ścieżce od korzenia.
+         * @details Porównywane są tylko pozycje od ostatniego nieodwracalnego ruchu. Ich liczbę
+         *          daje licznik ruchów królowymi, bo każda tura bez bicia i ruchu pionem to jeden ruch.
+         * @param gameState - rozpatrywany stan gry
+         * @param ply - odległość stanu od korzenia
+         */
+        bool is_path_repetition(const GameState &gameState, int ply) const;
+        /**
+         * @brief Wywołuje onProgress, jeśli od poprzedniego raportu minęło PROGRESS_INTERVAL.
+         */
+        void report_progress();
+        /**
+         * @brief Kopiuje ruchy korzenia do wyników alokowanych na stercie, które przeżywają przeszukiwanie.
+         */
+        static std::vector<RootMove> to_root_moves(const RootLines &lines);
+        /**
+         * @brief Przeszukuje kolejne ruchy korzenia do podanego momentu (nullopt - do końca).
+         * @return Czy przeszukiwanie się zakończyło.
+         */
+        bool advance(std::optional<std::chrono::steady_clock::time_point> until);
+        /**
+         * @brief Przeszukuje kolejny ruch korzenia na głębokości obecnej iteracji.
+         */
+        void search_root_move();
+        /**
+         * @brief Kończy iterację: porządkuje ruchy korzenia i decyduje o kolejnej iteracji.
+         */
+        void complete_iteration();
+        /**
+         * @brief Sprawdza czy upłynął czas przeszukiwania lub przyszło żądanie przerwania.
+         */
+        bool is_time_up() const;
+    };
+
+} // namespace checkers::bot
@@ -0,0 +1,257 @@
+/**
+ * @file Squares.hpp
+ * @author Maciej Wojno
+ * @brief Zawiera indeksowanie grywalnych pól planszy oraz tablice sąsiedztwa, skoków i promieni
+ *        generowane w czasie kompilacji dla każdego rozmiaru planszy.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace checkers
+{
+    /// Indeks grywalnego pola planszy: y * (SIZE / 2) + x / 2.
+    using Square = std::uint8_t;
+
+    /// Wartość oznaczająca brak pola (wyjście poza planszę).
+    constexpr Square NO_SQUARE = 0xFF;
+    /// Liczba kierunków po przekątnych.
+    constexpr int DIRECTIONS = 4;
+
+    /** \enum DirectionEnum
+     * @brief Kierunki po przekątnych. Kolejność odpowiada kolejności generowania ruchów królowej.
+     *
+     */
+    enum DirectionEnum
+    {
+        UP_RIGHT,   ///< (+1, +1)
+        UP_LEFT,    ///< (-1, +1)
+        DOWN_RIGHT, ///< (+1, -1)
+        DOWN_LEFT,  ///< (-1, -1)
+        NO_DIRECTION
+    };
+
+    namespace squares
+    {
+        constexpr int DIRECTION_DX[DIRECTIONS] = {1, -1, 1, -1};
+        constexpr int DIRECTION_DY[DIRECTIONS] = {1, 1, -1, -1};
+
+        /** \struct Layout
+         * @brief Indeksowanie ciemnych pól planszy SIZE x SIZE (lewe dolne pole jest ciemne).
+         */
+        template<int SIZE>
+        struct Layout
+        {
+            static_assert(SIZE % 2 == 0 && SIZE * SIZE / 2 <= 64, "squares must fit in a 64-bit mask");
+
+            /// Długość boku planszy.
+            static constexpr int BOARD_SIZE = SIZE;
+            /// Liczba grywalnych pól w jednym rzędzie.
+            static constexpr int ROW_SQUARES = SIZE / 2;
+            /// Liczba grywalnych pól planszy.
+            static constexpr int SQUARES = SIZE * SIZE / 2;
+            /// Najdłuższy możliwy promień po przekątnej (bez pola startowego).
+            static constexpr int MAX_RAY = SIZE - 1;
+
+            /// Czy pole o podanych współrzędnych jest ciemnym polem planszy.
+            static constexpr bool is_playable(int x, int y) {
+                return x >= 0 && x < SIZE && y >= 0 && y < SIZE && (x + y) % 2 == 0;
+            }
+
+            static constexpr Square to_square(int x, int y) {
+                return static_cast<Square>(y * ROW_SQUARES + x / 2);
+            }
+
+            static constexpr int square_x(Square square) {
+                return 2 * (square % ROW_SQUARES) + (square / ROW_SQUARES) % 2;
+            }
+
+            static constexpr int square_y(Square square) {
+                return square / ROW_SQUARES;
+            }
+        };
+
+        template<int SIZE>
+        using StepTable = std::array<std::array<Square, DIRECTIONS>, Layout<SIZE>::SQUARES>;
+
+        template<int SIZE>
+        constexpr StepTable<SIZE> make_step_table(int distance) {
+            using L = Layout<SIZE>;
+            StepTable<SIZE> table{};
+            for (int sq = 0; sq < L::SQUARES; ++sq) {
+                for (int dir = 0; dir < DIRECTIONS; ++dir) {
+                    int x = L::square_x(sq) + DIRECTION_DX[dir] * distance;
+                    int y = L::square_y(sq) + DIRECTION_DY[dir] * distance;
+                    table[sq][dir] = L::is_playable(x, y) ? L::to_square(x, y) : NO_SQUARE;
+                }
+            }
+            return table;
+        }
+
+        template<int SIZE>
+        struct RayTable
+        {
+            std::array<std::array<std::array<Square, Layout<SIZE>::MAX_RAY>, DIRECTIONS>, Layout<SIZE>::SQUARES> squares{};
+            std::array<std::array<std::uint8_t, DIRECTIONS>, Layout<SIZE>::SQUARES> length{};
+        };
+
+        template<int SIZE>
+        constexpr RayTable<SIZE> make_ray_table() {
+            using L = Layout<SIZE>;
+            RayTable<SIZE> table{};
+            for (int sq = 0; sq < L::SQUARES; ++sq) {
+                for (int dir = 0; dir < DIRECTIONS; ++dir) {
+                    int x = L::square_x(sq) + DIRECTION_DX[dir];
+                    int y = L::square_y(sq) + DIRECTION_DY[dir];
+                    int n = 0;
+                    while (L::is_playable(x, y)) {
+                        table.squares[sq][dir][n++] = L::to_square(x, y);
+                        x += DIRECTION_DX[dir];
+                        y += DIRECTION_DY[dir];
+                    }
+                    table.length[sq][dir] = static_cast<std::uint8_t>(n);
+                }
+            }
+            return table;
+        }
+
+        /// Kierunek i odległość pomiędzy dwoma polami leżącymi na wspólnej przekątnej.
+        struct Relation
+        {
+            std::uint8_t direction;
+            std::uint8_t distance;
+        };
+
+        template<int SIZE>
+        using RelationTable = std::array<std::array<Relation, Layout<SIZE>::SQUARES>, Layout<SIZE>::SQUARES>;
+
+        template<int SIZE>
+        constexpr RelationTable<SIZE> make_relation_table(const RayTable<SIZE> &rays) {
+            using L = Layout<SIZE>;
+            RelationTable<SIZE> table{};
+            for (int sq = 0; sq < L::SQUARES; ++sq) {
+                for (int target = 0; target < L::SQUARES; ++target) {
+                    table[sq][target] = Relation{NO_DIRECTION, 0};
+                }
+                for (int dir = 0; dir < DIRECTIONS; ++dir) {
+                    for (int i = 0; i < rays.length[sq][dir]; ++i) {
+                        Square target = rays.squares[sq][dir][i];
+                        table[sq][target].direction = static_cast<std::uint8_t>(dir);
+                        table[sq][target].distance = static_cast<std::uint8_t>(i + 1);
+                    }
+                }
+            }
+            return table;
+        }
+
+        /// Pola w kolejności przeglądania planszy kolumnami (x zewnętrzne, y wewnętrzne).
+        template<int SIZE>
+        constexpr std::array<Square, Layout<SIZE>::SQUARES> make_scan_order() {
+            using L = Layout<SIZE>;
+            std::array<Square, L::SQUARES> order{};
+            int n = 0;
+            for (int x = 0; x < SIZE; ++x) {
+                for (int y = 0; y < SIZE; ++y) {
+                    if (L::is_playable(x, y)) {
+                        order[n++] = L::to_square(x, y);
+                    }
+                }
+            }
+            return order;
+        }
+
+        /// Największa liczba pól, na które może wejść królowa z jednego pola (suma długości promieni).
+        template<int SIZE>
+        constexpr int max_targets(const RayTable<SIZE> &rays) {
+            int best = 0;
+            for (int sq = 0; sq < Layout<SIZE>::SQUARES; ++sq) {
+                int sum = 0;
+                for (int dir = 0; dir < DIRECTIONS; ++dir) {
+                    sum += rays.length[sq][dir];
+                }
+                best = sum > best ? sum : best;
+            }
+            return best;
+        }
+
+        /// Czy pole o podanych współrzędnych jest ciemnym polem planszy 8x8.
+        constexpr bool is_playable(int x, int y) {
+            return Layout<8>::is_playable(x, y);
+        }
+
+        constexpr Square to_square(int x, int y) {
+            return Layout<8>::to_square(x, y);
+        }
+
+        constexpr int square_x(Square square) {
+            return Layout<8>::square_x(square);
+        }
+
+        constexpr int square_y(Square square) {
+            return Layout<8>::square_y(square);
+        }
+    } // namespace squares
+
+    /** \struct Geometry
+     * @brief Geometria planszy SIZE x SIZE: maski bitowe pól i tablice ruchów liczone w czasie kompilacji.
+     * @details Każdy wariant gry korzysta z własnej instancji, więc generator ruchów odwołuje się
+     *          do stałych tablic zamiast sprawdzać rozmiar planszy w czasie działania.
+     */
+    template<int SIZE>
+    struct Geometry : squares::Layout<SIZE>
+    {
+        using Layout = squares::Layout<SIZE>;
+        /// Maska bitowa wszystkich pól planszy.
+        using Mask = std::conditional_t<Layout::SQUARES <= 32, std::uint32_t, std::uint64_t>;
+
+        /// Maska bitowa z ustawionym bitem odpowiadającym podanemu polu.
+        static constexpr Mask square_mask(Square square) {
+            return Mask{1} << square;
+        }
+
+        /// Sąsiednie pole w danym kierunku.
+        static constexpr auto NEIGHBOUR = squares::make_step_table<SIZE>(1);
+        /// Pole lądowania przy biciu pionem w danym kierunku.
+        static constexpr auto JUMP = squares::make_step_table<SIZE>(2);
+        /// Kolejne pola na przekątnej w danym kierunku oraz ich liczba.
+        static constexpr auto RAY = squares::make_ray_table<SIZE>();
+        /// Kierunek i odległość między parą pól (NO_DIRECTION jeśli nie leżą na wspólnej przekątnej).
+        static constexpr auto RELATION = squares::make_relation_table<SIZE>(RAY);
+        /// Kolejność przeglądania pól kolumnami planszy.
+        static constexpr auto SCAN_ORDER = squares::make_scan_order<SIZE>();
+        /// Największa liczba ruchów jednej bierki.
+        static constexpr int MAX_TARGETS = squares::max_targets<SIZE>(RAY);
+    };
+
+    /// Geometria planszy 8x8, na której toczy się rozgrywka programu.
+    using Board8 = Geometry<8>;
+
+    /// Liczba grywalnych pól planszy.
+    constexpr int SQUARES = Board8::SQUARES;
+    /// Najdłuższy możliwy promień po przekątnej (bez pola startowego).
+    constexpr int MAX_RAY = Board8::MAX_RAY;
+
+    /// Maska bitowa z ustawionym bitem odpowiadającym podanemu polu.
+    constexpr std::uint32_t square_mask(Square square) {
+        return Board8::square_mask(square);
+    }
+
+    /// Sąsiednie pole w danym kierunku.
+    inline constexpr const auto &NEIGHBOUR = Board8::NEIGHBOUR;
+    /// Pole lądowania przy biciu pionem w danym kierunku.
+    inline constexpr const auto &JUMP = Board8::JUMP;
+    /// Kolejne pola na przekątnej w danym kierunku oraz ich liczba.
+    inline constexpr const auto &RAY = Board8::RAY;
+    /// Kierunek i odległość między parą pól (NO_DIRECTION jeśli nie leżą na wspólnej przekątnej).
+    inline constexpr const auto &RELATION = Board8::RELATION;
+    /// Kolejność przeglądania pól zgodna z dotychczasowym przeglądaniem planszy fields[x][y].
+    inline constexpr const auto &SCAN_ORDER = Board8::SCAN_ORDER;
+
+} // namespace checkers
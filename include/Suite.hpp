@@ -0,0 +1,94 @@
+/**
+ * @file Suite.hpp
+ * @author Bartosz Świrta
+ * @brief Zawiera definicję klasy Suite - rozwiązywania zestawu pozycji testowych z pomiarem czasu
+ *        i liczby węzłów potrzebnych do znalezienia rozwiązania.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Game.hpp"
+#include "Config.hpp"
+
+namespace checkers
+{
+    /** \struct SuitePosition
+     * @brief Pozycja testowa wraz z ruchami uznawanymi za rozwiązanie.
+     */
+    struct SuitePosition
+    {
+        /// Nazwa pozycji (lub numer linii pliku, jeśli nie podano nazwy).
+        std::string name;
+        /// Stan gry w pozycji.
+        GameState gameState;
+        /// Ruchy będące rozwiązaniem.
+        std::vector<Move> solutions;
+    };
+
+    /** \struct SuiteResult
+     * @brief Wynik rozwiązywania jednej pozycji.
+     */
+    struct SuiteResult
+    {
+        /// Czy ruch wybrany na koniec przeszukiwania jest rozwiązaniem.
+        bool solved = false;
+        /// Ruch wybrany na koniec przeszukiwania.
+        std::optional<Move> bestMove = std::nullopt;
+        /// Głębokość, od której przeszukiwanie wskazywało już tylko rozwiązanie.
+        int depth = 0;
+        /// Czas do znalezienia rozwiązania (od którego przeszukiwanie już go nie zmieniło).
+        std::chrono::microseconds time{0};
+        /// Liczba węzłów do znalezienia rozwiązania.
+        std::uint64_t nodes = 0;
+    };
+
+    /**
+     * @brief Rozwiązuje zestaw pozycji testowych przy ograniczonym czasie lub liczbie węzłów.
+     * @details Plik zestawu zawiera po jednej pozycji w linii:
+     *          "(zapis pozycji) ; (ruchy rozwiązania) [; nazwa]", np.
+     *          "bbbb/bbbb/bbbb/..../..../wwww/wwww/wwww w - ; c3-d4 e3-d4 ; otwarcie".
+     *          Puste linie i linie zaczynające się od '#' są pomijane. Pozycje rozwiązywane są
+     *          równolegle, każdy wątek ma własne przeszukiwanie. Heurystyka i techniki przeszukiwania
+     *          selektywnego wybierane są według gracza wykonującego ruch (--wheuristic, --wlmr, ...).
+     */
+    class Suite
+    {
+    public:
+        /**
+         * @brief Konstruktor z podaną konfiguracją.
+         *
+         */
+        explicit Suite(const Config &config_);
+        /**
+         * @brief Wczytuje pozycje testowe z pliku.
+         *
+         * @param path - ścieżka do pliku zestawu
+         * @return std::optional<std::vector<SuitePosition>> - pozycje lub nullopt jeśli pliku nie da się odczytać
+         */
+        static std::optional<std::vector<SuitePosition>> try_load(const std::string &path);
+        /**
+         * @brief Rozwiązuje wszystkie pozycje i wypisuje wyniki na standardowe wyjście.
+         *
+         * @return Czy udało się wczytać zestaw.
+         */
+        bool run();
+
+    private:
+        /// Konfiguracja programu.
+        Config config;
+
+        /// Rozwiązuje jedną pozycję.
+        SuiteResult solve(const SuitePosition &position) const;
+    };
+
+} // namespace checkers
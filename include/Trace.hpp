@@ -0,0 +1,73 @@
+/**
+ * @file Trace.hpp
+ * @author Maciej Wojno
+ * @brief Zawiera deklarację zapisu przebiegu programu w formacie Chrome trace event
+ *        (do obejrzenia w chrome://tracing lub Perfetto).
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace checkers::trace
+{
+    /// Liczba zdarzeń pamiętanych dla jednego wątku. Starsze zdarzenia są nadpisywane.
+    constexpr std::size_t TRACE_BUFFER_EVENTS = 1 << 16;
+    /// Wartość oznaczająca zdarzenie bez argumentu.
+    constexpr std::int64_t NO_ARG = INT64_MIN;
+
+    /**
+     * @brief Włącza zbieranie zdarzeń, które zostaną zapisane do pliku przez finish().
+     * @param path - ścieżka pliku JSON
+     */
+    void start(const std::string &path);
+    /**
+     * @brief Zapisuje zebrane zdarzenia wszystkich wątków i wyłącza zbieranie.
+     * @details Wywoływane na końcu programu, po zakończeniu pozostałych wątków.
+     * @return Czy udało się zapisać plik (true także gdy zbieranie nie było włączone).
+     */
+    bool finish();
+    /**
+     * @return Czy zdarzenia są zbierane.
+     */
+    bool enabled();
+    /**
+     * @brief Nadaje nazwę ścieżce obecnego wątku w podglądzie przebiegu.
+     */
+    void set_thread_name(const char *name);
+
+    /**
+     * @brief Odcinek czasu od utworzenia do zniszczenia obiektu, zapisywany jako jedno zdarzenie.
+     * @details Zdarzenie trafia do bufora wątku, który utworzył obiekt. Bufory są pierścieniowe
+     *          i każdy ma jednego piszącego, więc zapis nie wymaga blokad. Gdy zbieranie jest
+     *          wyłączone, odcinek kosztuje tylko sprawdzenie flagi.
+     */
+    class Span
+    {
+    public:
+        /**
+         * @param name_ - nazwa zdarzenia, musi żyć do końca programu (literał)
+         * @param arg_ - opcjonalny argument liczbowy zdarzenia, np. głębokość iteracji
+         */
+        explicit Span(const char *name_, std::int64_t arg_ = NO_ARG);
+        ~Span();
+
+        Span(const Span &) = delete;
+        Span &operator=(const Span &) = delete;
+
+    private:
+        /// Nazwa zdarzenia lub nullptr jeśli zbieranie było wyłączone.
+        const char *name;
+        /// Argument zdarzenia.
+        std::int64_t arg;
+        /// Początek odcinka.
+        std::chrono::steady_clock::time_point begin;
+    };
+
+} // namespace checkers::trace
@@ -31,7 +31,7 @@ namespace checkers
          * @brief Konstruktor widoku z podaną konfiguracją.
          * 
          */
-        View(std::shared_ptr<MessageQueues> messageQueues);
+        View(std::shared_ptr<MessageQueues> messageQueues, bool showStats_ = false);
         virtual ~View();
         /**
          * @brief Uruchamia widok, przejmuje wątek na czas działania.
@@ -50,6 +50,16 @@ namespace checkers
          * 
          */
         std::optional<GameStateMessage> lastState;
+        /**
+         * @brief Czy pokazywać panel ze statystykami botów.
+         * 
+         */
+        bool showStats;
+        /**
+         * @brief Ostatnie statystyki botów otrzymane od kontrolera.
+         * 
+         */
+        std::optional<StatsMessage> lastStats;
         /**
          * @brief Funkcja aktualizacji interfejsu gracza.
          * 
@@ -60,7 +70,7 @@ namespace checkers
          * @brief Wyświetla przycisk na planszy w podanym stanie.
          *
          */
-        bool board_button(std::optional<PieceEnum> &pawn, bool is_selected, bool is_dark) const;
+        bool board_button(std::optional<PieceEnum> &pawn, bool is_selected, bool is_target, bool is_dark) const;
         /**
          * @brief Oblicza współczynnik skalowania tekstu w zależności od rozmiaru okna.
          * 
@@ -71,6 +81,11 @@ namespace checkers
          * 
          */
         void check_for_new_state();
+        /**
+         * @brief Wyświetla panel ze statystykami botów.
+         * 
+         */
+        void stats_panel();
         /**
          * @brief Wysyła akcję gracza do kontrolera.
          * 
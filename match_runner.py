@@ -0,0 +1,279 @@
+#!/usr/bin/python3
+
+# Rozproszone rozgrywanie gier z bot_tests.py: koordynator rozdaje gry procesom roboczym przez
+# gniazdo TCP i zbiera wyniki na bieżąco. Protokół to linie JSON:
+#   worker -> koordynator: {"type": "hello", "worker": nazwa}
+#   koordynator -> worker: {"type": "job", "name": plik logu, "params": parametry programu}
+#                          lub {"type": "done"} gdy nie ma więcej gier
+#   worker -> koordynator: {"type": "result", "name": ..., "log": treść logu}
+#                          lub {"type": "failed", "name": ..., "error": opis}
+# Gra, której worker nie odesłał (zerwane połączenie, przekroczony czas), wraca do kolejki.
+# Wyniki zapisywane są od razu, więc ponownie uruchomiony koordynator pomija rozegrane już gry.
+
+import argparse
+import json
+import os
+import shlex
+import socket
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+import bot_tests
+
+# Liczba nieudanych prób rozegrania gry, po której koordynator ją pomija.
+MAX_ATTEMPTS = 3
+
+
+class JobBoard:
+    def __init__(self, games):
+        self.condition = threading.Condition()
+        self.waiting = list(games)
+        self.running = 0
+        self.attempts = {}
+        self.failed = []
+
+    # Zwraca kolejną grę albo None, gdy wszystkie są rozegrane lub odrzucone.
+    def take(self):
+        with self.condition:
+            while not self.waiting and self.running > 0:
+                self.condition.wait()
+            if not self.waiting:
+                return None
+            self.running += 1
+            return self.waiting.pop(0)
+
+    def complete(self, game):
+        with self.condition:
+            self.running -= 1
+            self.condition.notify_all()
+
+    def retry(self, game, error):
+        with self.condition:
+            self.running -= 1
+            self.attempts[game["name"]] = self.attempts.get(game["name"], 0) + 1
+            if self.attempts[game["name"]] < MAX_ATTEMPTS:
+                self.waiting.append(game)
+            else:
+                self.failed.append((game["name"], error))
+            self.condition.notify_all()
+
+    def finished(self):
+        with self.condition:
+            return not self.waiting and self.running == 0
+
+
+def send_message(connection, message):
+    connection.sendall((json.dumps(message) + "\n").encode())
+
+
+def read_message(stream):
+    line = stream.readline()
+    if not line:
+        raise ConnectionError("connection closed")
+    return json.loads(line)
+
+
+def log_is_complete(log):
+    lines = log.split('\n')
+    return len(lines) >= 3 and lines[-2] in ("white_won", "black_won", "tie")
+
+
+def save_result(game, log):
+    path = "./match_results/" + game["name"]
+    with open(path, "w") as outf:
+        outf.write(log)
+    bot_tests.process_log(path, "results/" + game["name"])
+
+
+def serve_worker(connection, board, job_timeout, lock):
+    stream = connection.makefile("r")
+    try:
+        connection.settimeout(job_timeout)
+        hello = read_message(stream)
+        worker = hello.get("worker", "?")
+        while True:
+            game = board.take()
+            if game is None:
+                send_message(connection, {"type": "done"})
+                return
+            try:
+                send_message(connection, {"type": "job", "name": game["name"], "params": game["params"]})
+                reply = read_message(stream)
+            except (OSError, ValueError) as error:
+                board.retry(game, "worker %s lost: %s" % (worker, error))
+                return
+            if reply.get("type") == "result" and log_is_complete(reply.get("log", "")):
+                with lock:
+                    save_result(game, reply["log"])
+                    print("played game %s on %s" % (game["name"], worker), flush=True)
+                board.complete(game)
+            else:
+                board.retry(game, reply.get("error", "incomplete log"))
+    except (OSError, ValueError):
+        pass
+    finally:
+        stream.close()
+        connection.close()
+
+
+def coordinate(server, games, job_timeout):
+    board = JobBoard(games)
+    lock = threading.Lock()
+    threads = []
+    server.settimeout(0.5)
+    while not board.finished():
+        try:
+            connection, _ = server.accept()
+        except socket.timeout:
+            continue
+        threads.append(threading.Thread(target=serve_worker, args=(connection, board, job_timeout, lock), daemon=True))
+        threads[-1].start()
+    # Nikt nie czeka już na wynik gry, więc wątki tylko wysyłają workerom "done".
+    for thread in threads:
+        thread.join()
+    server.close()
+    for name, error in board.failed:
+        print("failed game %s: %s" % (name, error), flush=True)
+    return not board.failed
+
+
+def pending_games():
+    for directory in ("match_results", "results"):
+        os.makedirs(directory, exist_ok=True)
+    return [game for game in bot_tests.get_test_games() if not os.path.exists("results/" + game["name"])]
+
+
+def open_server(host, port):
+    server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    server.bind((host, port))
+    server.listen()
+    return server
+
+
+def finish(success):
+    if success:
+        bot_tests.create_matchup_report()
+        bot_tests.create_time_report()
+    return 0 if success else 1
+
+
+def run_coordinator(args):
+    games = pending_games()
+    print("%d games to play" % len(games), flush=True)
+    server = open_server(args.host, args.port)
+    print("listening on %s:%d" % server.getsockname(), flush=True)
+    return finish(coordinate(server, games, args.job_timeout))
+
+
+def play_game(executable, params):
+    handle, log_path = tempfile.mkstemp(suffix=".txt")
+    os.close(handle)
+    try:
+        command = shlex.split(executable) + shlex.split(bot_tests.BASE_PARAMS) + [log_path] + shlex.split(params)
+        process = subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE)
+        with open(log_path) as inf:
+            log = inf.read()
+        if process.returncode != 0:
+            return None, "exit code %d: %s" % (process.returncode, process.stderr.decode(errors="replace").strip())
+        return log, None
+    finally:
+        os.remove(log_path)
+
+
+def run_worker(args):
+    name = args.name or "%s-%d" % (socket.gethostname(), os.getpid())
+    deadline = time.monotonic() + args.connect_timeout
+    while True:
+        try:
+            connection = socket.create_connection((args.host, args.port))
+        except OSError:
+            if time.monotonic() > deadline:
+                print("coordinator unreachable", file=sys.stderr)
+                return 1
+            time.sleep(0.5)
+            continue
+        # Po rozłączeniu worker ponawia połączenie, np. gdy koordynator jest restartowany.
+        deadline = time.monotonic() + args.connect_timeout
+        stream = connection.makefile("r")
+        try:
+            send_message(connection, {"type": "hello", "worker": name})
+            while True:
+                message = read_message(stream)
+                if message["type"] == "done":
+                    return 0
+                log, error = play_game(args.executable, message["params"])
+                if log is None:
+                    send_message(connection, {"type": "failed", "name": message["name"], "error": error})
+                else:
+                    send_message(connection, {"type": "result", "name": message["name"], "log": log})
+        except (OSError, ValueError):
+            pass
+        finally:
+            stream.close()
+            connection.close()
+
+
+def run_local(args):
+    games = pending_games()
+    print("%d games to play" % len(games), flush=True)
+    server = open_server("127.0.0.1", 0)
+    port = server.getsockname()[1]
+    result = {}
+    coordinator = threading.Thread(target=lambda: result.update(success=coordinate(server, games, args.job_timeout)))
+    coordinator.start()
+
+    command = [sys.executable, os.path.abspath(__file__), "worker", "--port", str(port),
+               "--executable", args.executable]
+    workers = [subprocess.Popen(command + ["--name", "local-%d" % i]) for i in range(args.workers)]
+    # Workery, które zakończyły się przed końcem pracy koordynatora, są uruchamiane ponownie.
+    while coordinator.is_alive():
+        for i, worker in enumerate(workers):
+            if worker.poll() is not None and worker.returncode != 0:
+                print("restarting worker local-%d" % i, flush=True)
+                workers[i] = subprocess.Popen(command + ["--name", "local-%d" % i])
+        coordinator.join(0.5)
+    for worker in workers:
+        worker.wait()
+    return finish(result.get("success", False))
+
+
+def default_executable():
+    if sys.platform.startswith("win"):
+        return "powershell.exe ./bin/pszt_warcaby.exe"
+    return "./bin/pszt_warcaby"
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Distributed runner for the bot_tests.py games")
+    modes = parser.add_subparsers(dest="mode", required=True)
+
+    coordinator_parser = modes.add_parser("coordinator", help="hand out games to workers and collect results")
+    coordinator_parser.add_argument("--host", default="0.0.0.0")
+    coordinator_parser.add_argument("--port", type=int, default=5555)
+
+    worker_parser = modes.add_parser("worker", help="play games handed out by a coordinator")
+    worker_parser.add_argument("--host", default="127.0.0.1")
+    worker_parser.add_argument("--port", type=int, default=5555)
+    worker_parser.add_argument("--name")
+    worker_parser.add_argument("--connect-timeout", type=float, default=30.0)
+
+    local_parser = modes.add_parser("local", help="coordinator with local workers on loopback")
+    local_parser.add_argument("--workers", type=int, default=os.cpu_count() or 1)
+
+    for mode_parser in (coordinator_parser, local_parser):
+        mode_parser.add_argument("--job-timeout", type=float, default=3600.0,
+                                 help="seconds after which an unanswered game is handed to another worker")
+    for mode_parser in (worker_parser, local_parser):
+        mode_parser.add_argument("--executable", default=default_executable())
+
+    args = parser.parse_args()
+    if args.mode == "coordinator":
+        sys.exit(run_coordinator(args))
+    elif args.mode == "worker":
+        sys.exit(run_worker(args))
+    else:
+        sys.exit(run_local(args))
@@ -0,0 +1,562 @@
+/**
+ * @file Bench.cpp
+ * @author Bartosz Świrta
+ * @brief Zawiera definicję metod klasy Bench.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "../include/Bench.hpp"
+#include "../include/EvalCache.hpp"
+#include "../include/Game.hpp"
+#include "../include/Memory.hpp"
+#include "../include/Notation.hpp"
+#include "../include/Patterns.hpp"
+#include "../include/Search.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace checkers;
+
+namespace
+{
+    /** \struct BenchPosition
+     * @brief Pozycja zestawu wraz z głębokościami pomiarów.
+     */
+    struct BenchPosition
+    {
+        const char *name;
+        const char *position;
+        int perftDepth;
+        int searchDepth;
+    };
+
+    /// Stały zestaw pozycji: otwarcie, gra środkowa, gra królowymi i końcówka.
+    const BenchPosition POSITIONS[] = {
+        {"start", "bbbb/bbbb/bbbb/..../..../wwww/wwww/wwww w -", 7, 9},
+        {"opening", ".bbb/bbb./b..b/b.b./..../.w.w/wwww/w..w w -", 7, 10},
+        {"middlegame", "..bb/w.b./..b./..../.w../w..w/.www/.w.w b -", 7, 9},
+        {"queens", ".bWb/..b./bbb./..../..../.w../..../w... w -", 7, 10},
+        {"endgame", "..../w.../..../w.b./w.../w.../..../w..B b -", 8, 9},
+    };
+
+    /** \struct VariantPerft
+     * @brief Perft pozycji początkowej pozostałych wariantów gry.
+     */
+    struct VariantPerft
+    {
+        const char *name;
+        int perftDepth;
+    };
+
+    const VariantPerft ENGLISH_PERFT = {"english/start", 7};
+    const VariantPerft INTERNATIONAL_PERFT = {"international/start", 6};
+
+    const HeuristicEnum HEURISTICS[] = {BASIC, BOARD_AWARE, NNUE, PATTERN};
+
+    std::string heuristic_name(HeuristicEnum heuristic)
+    {
+        switch (heuristic) {
+            case BASIC: return "basic";
+            case A_BASIC: return "a_basic";
+            case BOARD_AWARE: return "board_aware";
+            case NNUE: return "nnue";
+            case PATTERN: return "pattern";
+        }
+        return "?";
+    }
+
+    /// Liczba pozycji po depth pełnych ruchach (łańcuch bić to jeden ruch).
+    template <typename State>
+    std::uint64_t perft(const State &gameState, int depth)
+    {
+        if (depth == 0) return 1;
+        if (gameState.get_game_progress() != PLAYING) return 0;
+        std::uint64_t nodes = 0;
+        for (auto move : gameState.legal_moves()) {
+            State next = gameState;
+            next.try_make_move(move);
+            bool chain = next.get_game_progress() == PLAYING
+                         && next.get_current_player() == gameState.get_current_player();
+            nodes += perft(next, chain ? depth : depth - 1);
+        }
+        return nodes;
+    }
+
+    /// Mierzy czas wywołania measure w milisekundach.
+    template <typename Function>
+    double time_ms(Function measure)
+    {
+        auto start = std::chrono::steady_clock::now();
+        measure();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /// Zapamiętuje alokacje powtórzenia pomiaru, jeśli jest ich mniej niż w poprzednich.
+    void keep_fewest(BenchResult &result, const memory::AllocationCounters &counters)
+    {
+        if (!result.allocations.has_value() || counters.allocations < result.allocations.value()) {
+            result.allocations = counters.allocations;
+            result.bytes = counters.bytes;
+        }
+    }
+
+    /// Mierzy perft podanego stanu gry, powtarzając pomiar runs razy.
+    template <typename State>
+    BenchResult measure_perft(const std::string &name, const State &gameState, int depth, int runs)
+    {
+        BenchResult result{name, "perft", gameState.to_string(), "", depth, 0, 0, ""};
+        for (int run = 0; run < runs; ++run) {
+            memory::AllocationScope allocations;
+            double time = time_ms([&]() { result.nodes = perft(gameState, depth); });
+            result.timeMs = run == 0 ? time : std::min(result.timeMs, time);
+            keep_fewest(result, allocations.elapsed());
+        }
+        return result;
+    }
+
+    /// Mierzy perft pozycji początkowej wariantu o podanym stanie gry.
+    template <typename State>
+    BenchResult measure_variant_perft(const VariantPerft &variant, int runs)
+    {
+        State gameState;
+        gameState.init();
+        return measure_perft(variant.name, gameState, variant.perftDepth, runs);
+    }
+
+    std::string quoted(const std::string &text)
+    {
+        std::string result = "\"";
+        for (char c : text) {
+            if (c == '"' || c == '\\') result.push_back('\\');
+            result.push_back(c);
+        }
+        return result + "\"";
+    }
+
+    /** \struct JsonValue
+     * @brief Wartość JSON odczytana przez JsonReader (bez wartości logicznych, które nie występują w wynikach).
+     */
+    struct JsonValue
+    {
+        enum { NUL, NUMBER, STRING, ARRAY, OBJECT } type = NUL;
+        double number = 0;
+        std::string text;
+        std::vector<JsonValue> items;
+        std::vector<std::pair<std::string, JsonValue>> members;
+
+        const JsonValue *find(const std::string &key) const
+        {
+            for (const auto &member : members) {
+                if (member.first == key) return &member.second;
+            }
+            return nullptr;
+        }
+    };
+
+    /**
+     * @brief Prosty parser JSON wystarczający do odczytu plików zapisanych przez Bench::save.
+     */
+    class JsonReader
+    {
+    public:
+        explicit JsonReader(const std::string &text_) : text(text_) {}
+
+        std::optional<JsonValue> parse()
+        {
+            auto value = parse_value();
+            skip_spaces();
+            if (!value.has_value() || position != text.size()) return std::nullopt;
+            return value;
+        }
+
+    private:
+        const std::string &text;
+        std::size_t position = 0;
+
+        void skip_spaces()
+        {
+            while (position < text.size() && std::isspace(static_cast<unsigned char>(text[position]))) ++position;
+        }
+
+        bool consume(char c)
+        {
+            skip_spaces();
+            if (position >= text.size() || text[position] != c) return false;
+            ++position;
+            return true;
+        }
+
+        std::optional<std::string> parse_string()
+        {
+            if (!consume('"')) return std::nullopt;
+            std::string result;
+            while (position < text.size() && text[position] != '"') {
+                if (text[position] == '\\' && position + 1 < text.size()) ++position;
+                result.push_back(text[position++]);
+            }
+            if (position >= text.size()) return std::nullopt;
+            ++position;
+            return result;
+        }
+
+        std::optional<JsonValue> parse_value()
+        {
+            skip_spaces();
+            if (position >= text.size()) return std::nullopt;
+            JsonValue value;
+            char c = text[position];
+            if (c == '{') {
+                ++position;
+                value.type = JsonValue::OBJECT;
+                if (consume('}')) return value;
+                do {
+                    auto key = parse_string();
+                    if (!key.has_value() || !consume(':')) return std::nullopt;
+                    auto member = parse_value();
+                    if (!member.has_value()) return std::nullopt;
+                    value.members.emplace_back(key.value(), member.value());
+                } while (consume(','));
+                if (!consume('}')) return std::nullopt;
+            } else if (c == '[') {
+                ++position;
+                value.type = JsonValue::ARRAY;
+                if (consume(']')) return value;
+                do {
+                    auto item = parse_value();
+                    if (!item.has_value()) return std::nullopt;
+                    value.items.push_back(item.value());
+                } while (consume(','));
+                if (!consume(']')) return std::nullopt;
+            } else if (c == '"') {
+                auto string = parse_string();
+                if (!string.has_value()) return std::nullopt;
+                value.type = JsonValue::STRING;
+                value.text = string.value();
+            } else if (text.compare(position, 4, "null") == 0) {
+                position += 4;
+            } else {
+                std::size_t length = 0;
+                try {
+                    value.number = std::stod(text.substr(position, 32), &length);
+                } catch (std::exception &) {
+                    return std::nullopt;
+                }
+                position += length;
+                value.type = JsonValue::NUMBER;
+            }
+            return value;
+        }
+    };
+
+    double nps(std::uint64_t nodes, double timeMs)
+    {
+        return timeMs > 0 ? nodes * 1000.0 / timeMs : 0;
+    }
+
+    /// Zmiana względem wartości bazowej w procentach.
+    double change_percent(double value, double base)
+    {
+        return base > 0 ? (value - base) * 100.0 / base : 0;
+    }
+} // namespace
+
+/**
+ * @brief Konstruktor z podaną konfiguracją.
+ *
+ * @param config_ - struktura przechowująca dane konfiguracyjne.
+ */
+Bench::Bench(const Config &config_)
+    : config(config_)
+{
+}
+
+/**
+ * @brief Wykonuje wszystkie pomiary zestawu.
+ * @details Perft mierzy sam generator ruchów, przeszukiwania - generator razem z heurystykami.
+ *          Perft pozycji początkowych warcabów angielskich i międzynarodowych pilnuje
+ *          generatora ruchów tych wariantów.
+ *          Dodatkowy pomiar z włączonymi technikami przeszukiwania selektywnego obejmuje
+ *          redukcje, odcinanie i przedłużenia, wyłączone w pozostałych pomiarach.
+ *
+ * @return std::vector<BenchResult> - wyniki w stałej kolejności
+ */
+std::vector<BenchResult> Bench::measure() const
+{
+    int runs = std::max(1, config.benchRuns);
+    std::vector<BenchResult> results;
+    // Tablica ocen, sieć startowa i tablice wzorców są tworzone przy pierwszym użyciu - nie w pomiarze.
+    bot::shared_eval_cache();
+    bot::active_network();
+    bot::active_pattern_tables();
+    for (const BenchPosition &benchPosition : POSITIONS) {
+        GameState gameState = GameState::try_from_string(benchPosition.position).value();
+
+        results.push_back(measure_perft(std::string(benchPosition.name) + "/perft", gameState,
+                                        benchPosition.perftDepth, runs));
+
+        std::vector<std::pair<HeuristicEnum, bool>> searches;
+        for (HeuristicEnum heuristic : HEURISTICS) {
+            searches.emplace_back(heuristic, false);
+        }
+        searches.emplace_back(BASIC, true);
+
+        for (auto [heuristic, selective] : searches) {
+            bot::SearchLimits limits;
+            limits.depth = benchPosition.searchDepth;
+            limits.features = SearchFeatures{selective, selective, selective, selective};
+            BenchResult result{std::string(benchPosition.name) + "/" + heuristic_name(heuristic)
+                                       + (selective ? "/selective" : ""),
+                               "search", benchPosition.position, heuristic_name(heuristic),
+                               benchPosition.searchDepth, 0, 0, ""};
+            for (int run = 0; run < runs; ++run) {
+                // Każde powtórzenie zaczyna z pustą tablicą ocen, jak pierwsze.
+                bot::shared_eval_cache().clear();
+                memory::AllocationScope allocations;
+                std::vector<bot::RootMove> best;
+                double time;
+                {
+                    bot::Search search(heuristic);
+                    time = time_ms([&]() { best = search.run(gameState, limits); });
+                    result.nodes = search.get_nodes();
+                }
+                result.timeMs = run == 0 ? time : std::min(result.timeMs, time);
+                keep_fewest(result, allocations.elapsed());
+                result.move = best.empty() ? "none" : move_to_string(gameState, best.front().move);
+            }
+            results.push_back(result);
+        }
+    }
+    // Pozostałe warianty korzystają z tego samego generatora ruchów (inne instancje BasicGameState).
+    results.push_back(measure_variant_perft<EnglishGameState>(ENGLISH_PERFT, runs));
+    results.push_back(measure_variant_perft<InternationalGameState>(INTERNATIONAL_PERFT, runs));
+    return results;
+}
+
+/**
+ * @brief Zapisuje wyniki do pliku JSON, każdy pomiar w osobnej linii, oraz sumę węzłów i czasu
+ *        wraz z największą zajętą pamięcią procesu.
+ *
+ * @param path - ścieżka pliku
+ * @param results - zapisywane wyniki
+ * @return Czy udało się zapisać plik.
+ */
+bool Bench::save(const std::string &path, const std::vector<BenchResult> &results)
+{
+    std::ofstream file(path);
+    if (!file) return false;
+
+    std::uint64_t totalNodes = 0;
+    double totalTime = 0;
+    file << std::fixed << std::setprecision(3);
+    file << "{\n  \"version\": 1,\n  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const BenchResult &result = results[i];
+        totalNodes += result.nodes;
+        totalTime += result.timeMs;
+        file << "    {\"name\": " << quoted(result.name)
+             << ", \"kind\": " << quoted(result.kind)
+             << ", \"position\": " << quoted(result.position)
+             << ", \"heuristic\": " << quoted(result.heuristic)
+             << ", \"depth\": " << result.depth
+             << ", \"nodes\": " << result.nodes
+             << ", \"time_ms\": " << result.timeMs
+             << ", \"nps\": " << std::llround(nps(result.nodes, result.timeMs))
+             << ", \"move\": " << quoted(result.move);
+        if (result.allocations.has_value()) {
+            file << ", \"allocations\": " << result.allocations.value() << ", \"bytes\": " << result.bytes.value_or(0);
+        }
+        file << "}"
+             << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    file << "  ],\n  \"total\": {\"nodes\": " << totalNodes << ", \"time_ms\": " << totalTime
+         << ", \"nps\": " << std::llround(nps(totalNodes, totalTime));
+    if (auto resident = memory::read_resident_memory()) {
+        file << ", \"peak_rss_kb\": " << resident.value().peakResidentKb;
+    }
+    file << "}\n}\n";
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief Wczytuje wyniki zapisane metodą save.
+ *
+ * @param path - ścieżka pliku
+ * @return std::optional<std::vector<BenchResult>> - wyniki lub nullopt jeśli pliku nie da się odczytać
+ */
+std::optional<std::vector<BenchResult>> Bench::try_load(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file) return std::nullopt;
+    std::stringstream content;
+    content << file.rdbuf();
+    std::string text = content.str();
+
+    auto json = JsonReader(text).parse();
+    if (!json.has_value() || json.value().type != JsonValue::OBJECT) return std::nullopt;
+    const JsonValue *list = json.value().find("results");
+    if (list == nullptr || list->type != JsonValue::ARRAY) return std::nullopt;
+
+    std::vector<BenchResult> results;
+    for (const JsonValue &item : list->items) {
+        const JsonValue *name = item.find("name");
+        const JsonValue *nodes = item.find("nodes");
+        const JsonValue *time = item.find("time_ms");
+        if (name == nullptr || name->type != JsonValue::STRING || nodes == nullptr
+            || nodes->type != JsonValue::NUMBER || time == nullptr || time->type != JsonValue::NUMBER) {
+            return std::nullopt;
+        }
+        BenchResult result;
+        result.name = name->text;
+        result.nodes = static_cast<std::uint64_t>(nodes->number);
+        result.timeMs = time->number;
+        if (const JsonValue *move = item.find("move")) result.move = move->text;
+        if (const JsonValue *kind = item.find("kind")) result.kind = kind->text;
+        if (const JsonValue *depth = item.find("depth")) result.depth = static_cast<int>(depth->number);
+        const JsonValue *allocations = item.find("allocations");
+        if (allocations != nullptr && allocations->type == JsonValue::NUMBER) {
+            result.allocations = static_cast<std::uint64_t>(allocations->number);
+        }
+        const JsonValue *bytes = item.find("bytes");
+        if (bytes != nullptr && bytes->type == JsonValue::NUMBER) {
+            result.bytes = static_cast<std::uint64_t>(bytes->number);
+        }
+        results.push_back(result);
+    }
+    return results;
+}
+
+/**
+ * @brief Porównuje wyniki z bazowymi i wypisuje różnice.
+ * @details Liczba węzłów, alokacje i ruch porównywane są dla każdego pomiaru, a czas dla sumy pomiarów
+ *          mających odpowiednik w wyniku bazowym. Pomiary bez odpowiednika są tylko wypisywane.
+ *
+ * @param results - obecne wyniki
+ * @param baseline - wyniki bazowe
+ * @return Czy nie ma regresji.
+ */
+bool Bench::compare(const std::vector<BenchResult> &results, const std::vector<BenchResult> &baseline) const
+{
+    bool passed = true;
+    std::uint64_t nodes = 0;
+    std::uint64_t baseNodes = 0;
+    double time = 0;
+    double baseTime = 0;
+
+    std::cout << std::fixed << std::setprecision(1);
+    for (const BenchResult &result : results) {
+        auto base = std::find_if(baseline.begin(), baseline.end(), [&](const BenchResult &other) {
+            return other.name == result.name;
+        });
+        std::cout << std::left << std::setw(28) << result.name;
+        if (base == baseline.end()) {
+            std::cout << " new" << std::endl;
+            continue;
+        }
+        nodes += result.nodes;
+        baseNodes += base->nodes;
+        time += result.timeMs;
+        baseTime += base->timeMs;
+
+        double nodeChange = change_percent(static_cast<double>(result.nodes), static_cast<double>(base->nodes));
+        double timeChange = change_percent(result.timeMs, base->timeMs);
+        std::cout << " nodes " << std::showpos << nodeChange << "%" << std::noshowpos
+                  << " time " << result.timeMs << " ms (" << std::showpos << timeChange << "%" << std::noshowpos << ")";
+
+        if (result.allocations.has_value() && base->allocations.has_value()) {
+            std::cout << " allocations " << result.allocations.value() << " (base " << base->allocations.value() << ")";
+        }
+
+        std::vector<std::string> problems;
+        if (std::abs(nodeChange) > config.benchNodeTolerance) problems.push_back("nodes");
+        if (result.allocations.has_value() && base->allocations.has_value()
+            && change_percent(static_cast<double>(result.allocations.value()),
+                              static_cast<double>(base->allocations.value())) > config.benchNodeTolerance) {
+            problems.push_back("allocations");
+        }
+        if (result.move != base->move) problems.push_back("move " + base->move + " -> " + result.move);
+        for (const auto &problem : problems) {
+            std::cout << " REGRESSION " << problem;
+        }
+        // Czas pojedynczego pomiaru jest zbyt zaszumiony, żeby sam w sobie był regresją.
+        if (timeChange > config.benchTolerance) std::cout << " slower";
+        std::cout << std::endl;
+        passed = passed && problems.empty();
+    }
+    for (const BenchResult &base : baseline) {
+        bool present = std::any_of(results.begin(), results.end(), [&](const BenchResult &result) {
+            return result.name == base.name;
+        });
+        if (!present) std::cout << std::left << std::setw(28) << base.name << " missing" << std::endl;
+    }
+
+    double totalChange = change_percent(time, baseTime);
+    std::cout << "total nodes " << nodes << " (base " << baseNodes << ") time " << time << " ms (base "
+              << baseTime << " ms, " << std::showpos << totalChange << "%" << std::noshowpos << ")"
+              << " nps " << std::llround(nps(nodes, time)) << " (base " << std::llround(nps(baseNodes, baseTime))
+              << ")" << std::endl;
+    if (totalChange > config.benchTolerance) {
+        std::cout << "REGRESSION total time" << std::endl;
+        passed = false;
+    }
+    std::cout << (passed ? "bench passed" : "bench failed") << std::endl;
+    return passed;
+}
+
+/**
+ * @brief Wykonuje pomiary, zapisuje je do config.benchPath i porównuje z config.benchBaseline.
+ *
+ * @return Czy pomiar się udał i nie wykazał regresji.
+ */
+bool Bench::run()
+{
+    std::optional<std::vector<BenchResult>> baseline;
+    if (config.benchBaseline.has_value()) {
+        baseline = try_load(config.benchBaseline.value());
+        if (!baseline.has_value()) {
+            std::cerr << "Cannot read bench baseline " << config.benchBaseline.value() << std::endl;
+            return false;
+        }
+    }
+
+    bool wasCounting = memory::counting();
+    memory::set_counting(true);
+    std::vector<BenchResult> results = measure();
+    memory::set_counting(wasCounting);
+    if (!save(config.benchPath.value(), results)) {
+        std::cerr << "Cannot write bench results " << config.benchPath.value() << std::endl;
+        return false;
+    }
+    if (auto resident = memory::read_resident_memory()) {
+        std::cout << "peak rss " << resident.value().peakResidentKb << " kB" << std::endl;
+    }
+
+    if (!baseline.has_value()) {
+        std::uint64_t nodes = 0;
+        double time = 0;
+        std::cout << std::fixed << std::setprecision(1);
+        for (const BenchResult &result : results) {
+            nodes += result.nodes;
+            time += result.timeMs;
+            std::cout << std::left << std::setw(28) << result.name << " nodes " << result.nodes
+                      << " time " << result.timeMs << " ms nps " << std::llround(nps(result.nodes, result.timeMs))
+                      << (result.move.empty() ? "" : " move " + result.move)
+                      << " allocations " << result.allocations.value_or(0) << " bytes " << result.bytes.value_or(0)
+                      << std::endl;
+        }
+        std::cout << "total nodes " << nodes << " time " << time << " ms nps "
+                  << std::llround(nps(nodes, time)) << std::endl;
+        return true;
+    }
+    return compare(results, baseline.value());
+}
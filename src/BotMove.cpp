@@ -10,51 +10,35 @@
  */
 
 #include "../include/BotMove.hpp"
-#include <climits>
+#include "../include/Nnue.hpp"
+#include "../include/Patterns.hpp"
+#include "../include/Trace.hpp"
 
 using namespace checkers;
 using namespace checkers::bot;
 
-std::pair<Coord, Coord> checkers::bot::bot_move(const GameState &gameState, PlayerEnum player, HeuristicEnum heuristicType, int depth)
+std::pair<Coord, Coord> checkers::bot::bot_move(const GameState &gameState, HeuristicEnum heuristicType, int depth,
+                                                const SearchFeatures &features,
+                                                const std::function<void(const SearchInfo &)> &progress,
+                                                std::pmr::memory_resource *memory)
 {
-    std::pair<Coord, Coord> bestMove = std::make_pair(Coord(0,0), Coord(0,0));
-    int bestScore = 0, score = 0;
-    GameState localState = gameState;
-    if(player == WHITE){
-        bestScore = INT_MIN;
-        for(auto piece : gameState.pieces_with_moves()) {
-            for (auto move : gameState.piece_moves(piece)) {
-                if (localState.try_make_move(piece, move))
-                    score = minimax(localState, depth - 1, INT_MIN, INT_MAX, BLACK, heuristicType);
-                localState = gameState;
-
-                if (bestScore < score)
-                {
-                    bestScore = score;
-                    bestMove.first = piece;
-                    bestMove.second = move;
-                }
-            }
-        }
+    trace::Span span("bot_move", depth);
+    SearchLimits limits;
+    limits.depth = depth;
+    limits.features = features;
+    Search search(heuristicType, memory);
+    search.set_progress_callback(progress);
+    std::vector<RootMove> best = search.run(gameState, limits);
+    if (best.empty()) {
+        return std::make_pair(Coord(0,0), Coord(0,0));
     }
-    else{
-        bestScore = INT_MAX;
-        for(auto piece : gameState.pieces_with_moves()) {
-            for (auto move : gameState.piece_moves(piece)) {
-                if (localState.try_make_move(piece, move))
-                    score = minimax(localState, depth - 1, INT_MIN, INT_MAX, WHITE, heuristicType);
-                localState = gameState;
+    return std::make_pair(to_coord(best.front().move.from), to_coord(best.front().move.to));
+}
 
-                if (bestScore > score)
-                {
-                    bestScore = score;
-                    bestMove.first = piece;
-                    bestMove.second = move;
-                }
-            }
-        }
-    }
-    return bestMove;
+std::vector<RootMove> checkers::bot::analyse(const GameState &gameState, HeuristicEnum heuristicType, const SearchLimits &limits,
+                                             std::pmr::memory_resource *memory)
+{
+    return Search(heuristicType, memory).run(gameState, limits);
 }
 
 int checkers::bot::basic_heuristic(const GameState &gameState){
@@ -189,46 +173,12 @@ int checkers::bot::estimate_move(const GameState &gameState, HeuristicEnum heuri
         case checkers::BOARD_AWARE:
             score = board_aware_heuristic(gameState);
             break;
+        case checkers::NNUE:
+            score = active_network().evaluate(gameState);
+            break;
+        case checkers::PATTERN:
+            score = active_pattern_tables().evaluate(gameState);
+            break;
     }
     return score;
 }
-
-int checkers::bot::minimax(const GameState &gameState, int depth, int alpha, int beta, PlayerEnum player, HeuristicEnum heuristicType)
-{
-    if (!depth || gameState.get_game_progress() != PLAYING)
-    {
-        return estimate_move(gameState, heuristicType);
-    }
-    int score = 0;
-    GameState localState = gameState;
-    if(player == WHITE){
-        for(auto piece : gameState.pieces_with_moves()){
-            for(auto move : gameState.piece_moves(piece)){
-                if(localState.try_make_move(piece, move))
-                    score = minimax(localState, depth - 1, alpha, beta, BLACK, heuristicType);
-                localState = gameState;
-
-                //alpha-beta pruning (dwie linie)
-                alpha = std::max(alpha, score);
-                if(beta <= alpha)
-                    return beta;
-            }
-        }
-        return alpha;
-    }
-    else{
-        for(auto piece : gameState.pieces_with_moves()){
-            for(auto move : gameState.piece_moves(piece)){
-                if(localState.try_make_move(piece, move))
-                    score = minimax(localState, depth - 1, alpha, beta, WHITE, heuristicType);
-                localState = gameState;
-
-                //alpha-beta pruning (dwie linie)
-                beta = std::min(beta, score);
-                if(beta <= alpha)
-                    return alpha;
-            }
-        }
-        return beta;
-    }
-}
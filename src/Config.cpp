@@ -10,12 +10,22 @@
  */
 #include "../include/Config.hpp"
 
+#include <algorithm>
 #include <optional>
 #include <string>
 #include <fstream>
 
 using namespace checkers;
 
+namespace
+{
+    std::optional<bool> bool_from_string(const std::string &text)
+    {
+        if (text == "true") return true;
+        if (text == "false") return false;
+        return std::nullopt;
+    }
+} // namespace
 
 /**
  * @brief Próbuje wczytać dane konfiguracyjne z argumentów wywołania programu.
@@ -55,25 +65,13 @@ std::optional<Config> Config::try_from_args(int argc, char *argv[])
                 return std::nullopt;
             }
         } else if (std::string(argv[i]) == "--wheuristic") {
-            if (std::string(argv[i+1]) == "basic") {
-                config.whiteBotHeuristic = BASIC;
-            } else if (std::string(argv[i+1]) == "a_basic") {
-                config.whiteBotHeuristic = A_BASIC;
-            } else if (std::string(argv[i+1]) == "board_aware") {
-                config.whiteBotHeuristic = BOARD_AWARE;
-            } else {
-                return std::nullopt;
-            }
+            auto heuristic = heuristic_from_string(argv[i+1]);
+            if (!heuristic.has_value()) return std::nullopt;
+            config.whiteBotHeuristic = heuristic.value();
         } else if (std::string(argv[i]) == "--bheuristic") {
-            if (std::string(argv[i+1]) == "basic") {
-                config.blackBotHeuristic = BASIC;
-            } else if (std::string(argv[i+1]) == "a_basic") {
-                config.blackBotHeuristic = A_BASIC;
-            } else if (std::string(argv[i+1]) == "board_aware") {
-                config.blackBotHeuristic = BOARD_AWARE;
-            } else {
-                return std::nullopt;
-            }
+            auto heuristic = heuristic_from_string(argv[i+1]);
+            if (!heuristic.has_value()) return std::nullopt;
+            config.blackBotHeuristic = heuristic.value();
         } else if (std::string(argv[i]) == "--log") {
             try {
                 std::ofstream f(argv[i+1]);
@@ -91,10 +89,169 @@ std::optional<Config> Config::try_from_args(int argc, char *argv[])
             } else {
                 return std::nullopt;
             }
+        } else if (std::string(argv[i]) == "--stats") {
+            auto enabled = bool_from_string(argv[i + 1]);
+            if (!enabled.has_value()) return std::nullopt;
+            config.showStats = enabled.value();
+        } else if (std::string(argv[i]) == "--engine") {
+            if (std::string(argv[i+1]) == "true") {
+                config.engineMode = true;
+            } else if (std::string(argv[i+1]) == "false") {
+                config.engineMode = false;
+            } else {
+                return std::nullopt;
+            }
+        } else if (std::string(argv[i]) == "--wlmr" || std::string(argv[i]) == "--blmr"
+                   || std::string(argv[i]) == "--wfutility" || std::string(argv[i]) == "--bfutility"
+                   || std::string(argv[i]) == "--wextend" || std::string(argv[i]) == "--bextend"
+                   || std::string(argv[i]) == "--wendgame" || std::string(argv[i]) == "--bendgame") {
+            auto enabled = bool_from_string(argv[i + 1]);
+            if (!enabled.has_value()) return std::nullopt;
+            std::string option(argv[i] + 3);
+            SearchFeatures &features = argv[i][2] == 'w' ? config.whiteSearchFeatures : config.blackSearchFeatures;
+            if (option == "lmr") {
+                features.lateMoveReductions = enabled.value();
+            } else if (option == "futility") {
+                features.futilityPruning = enabled.value();
+            } else if (option == "endgame") {
+                features.endgameKnowledge = enabled.value();
+            } else {
+                features.captureExtensions = enabled.value();
+            }
+        } else if (std::string(argv[i]) == "--wsearch") {
+            auto search = search_from_string(argv[i+1]);
+            if (!search.has_value()) return std::nullopt;
+            config.whiteSearch = search.value();
+        } else if (std::string(argv[i]) == "--bsearch") {
+            auto search = search_from_string(argv[i+1]);
+            if (!search.has_value()) return std::nullopt;
+            config.blackSearch = search.value();
+        } else if (std::string(argv[i]) == "--mctsiterations") {
+            try {
+                config.mcts.iterations = std::stoi(std::string(argv[i + 1]));
+            } catch (std::exception &) {
+                return std::nullopt;
+            }
+        } else if (std::string(argv[i]) == "--mctstime") {
+            try {
+                config.mcts.time = std::stoi(std::string(argv[i + 1]));
+            } catch (std::exception &) {
+                return std::nullopt;
+            }
+        } else if (std::string(argv[i]) == "--mctsthreads") {
+            try {
+                config.mcts.threads = std::max(1, std::stoi(std::string(argv[i + 1])));
+            } catch (std::exception &) {
+                return std::nullopt;
+            }
+        } else if (std::string(argv[i]) == "--mctsplayout") {
+            if (std::string(argv[i+1]) == "random") {
+                config.mcts.playout = RANDOM_PLAYOUT;
+            } else if (std::string(argv[i+1]) == "heuristic") {
+                config.mcts.playout = HEURISTIC_PLAYOUT;
+            } else {
+                return std::nullopt;
+            }
+        } else if (std::string(argv[i]) == "--nnue") {
+            config.nnuePath = std::string(argv[i + 1]);
+        } else if (std::string(argv[i]) == "--nnuesave") {
+            config.nnueSavePath = std::string(argv[i + 1]);
+        } else if (std::string(argv[i]) == "--patterns") {
+            config.patternsPath = std::string(argv[i + 1]);
+        } else if (std::string(argv[i]) == "--patternsave") {
+            config.patternsSavePath = std::string(argv[i + 1]);
+        } else if (std::string(argv[i]) == "--suite") {
+            config.suitePath = std::string(argv[i + 1]);
+        } else if (std::string(argv[i]) == "--suitetime") {
+            try {
+                config.suiteTime = std::stoi(std::string(argv[i + 1]));
+            } catch (std::exception &) {
+                return std::nullopt;
+            }
+        } else if (std::string(argv[i]) == "--suitenodes") {
+            try {
+                config.suiteNodes = std::stoll(std::string(argv[i + 1]));
+            } catch (std::exception &) {
+                return std::nullopt;
+            }
+        } else if (std::string(argv[i]) == "--replay") {
+            config.replayPaths.push_back(std::string(argv[i + 1]));
+        } else if (std::string(argv[i]) == "--bench") {
+            config.benchPath = std::string(argv[i + 1]);
+        } else if (std::string(argv[i]) == "--benchbaseline") {
+            config.benchBaseline = std::string(argv[i + 1]);
+        } else if (std::string(argv[i]) == "--benchtolerance" || std::string(argv[i]) == "--benchnodetolerance") {
+            try {
+                double tolerance = std::stod(std::string(argv[i + 1]));
+                if (tolerance < 0) return std::nullopt;
+                (argv[i][7] == 't' ? config.benchTolerance : config.benchNodeTolerance) = tolerance;
+            } catch (std::exception &) {
+                return std::nullopt;
+            }
+        } else if (std::string(argv[i]) == "--benchruns") {
+            try {
+                config.benchRuns = std::max(1, std::stoi(std::string(argv[i + 1])));
+            } catch (std::exception &) {
+                return std::nullopt;
+            }
+        } else if (std::string(argv[i]) == "--trace") {
+            std::ofstream f(argv[i+1]);
+            if (!f) return std::nullopt;
+            config.tracePath = std::string(argv[i + 1]);
+        } else if (std::string(argv[i]) == "--memstats") {
+            auto enabled = bool_from_string(argv[i + 1]);
+            if (!enabled.has_value()) return std::nullopt;
+            config.memoryStats = enabled.value();
+        } else if (std::string(argv[i]) == "--threads") {
+            try {
+                config.threads = std::stoi(std::string(argv[i + 1]));
+            } catch (std::exception &) {
+                return std::nullopt;
+            }
         } else {
             return std::nullopt;
         }
     }
 
     return config;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Odczytuje nazwę heurystyki (basic/a_basic/board_aware/nnue/pattern).
+ *
+ * @param name - nazwa heurystyki
+ * @return std::optional<HeuristicEnum> - heurystyka lub nullopt jeśli nazwa jest nieznana
+ */
+std::optional<HeuristicEnum> checkers::heuristic_from_string(const std::string &name)
+{
+    if (name == "basic") {
+        return BASIC;
+    } else if (name == "a_basic") {
+        return A_BASIC;
+    } else if (name == "board_aware") {
+        return BOARD_AWARE;
+    } else if (name == "nnue") {
+        return NNUE;
+    } else if (name == "pattern") {
+        return PATTERN;
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Odczytuje nazwę algorytmu przeszukiwania (alphabeta/mcts_root/mcts_tree).
+ *
+ * @param name - nazwa algorytmu
+ * @return std::optional<SearchEnum> - algorytm lub nullopt jeśli nazwa jest nieznana
+ */
+std::optional<SearchEnum> checkers::search_from_string(const std::string &name)
+{
+    if (name == "alphabeta") {
+        return ALPHA_BETA;
+    } else if (name == "mcts_root") {
+        return MCTS_ROOT;
+    } else if (name == "mcts_tree") {
+        return MCTS_TREE;
+    }
+    return std::nullopt;
+}
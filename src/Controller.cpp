@@ -11,8 +11,13 @@
 
 #include "../include/Controller.hpp"
 #include "../include/BotMove.hpp"
+#include "../include/Mcts.hpp"
+#include "../include/Notation.hpp"
+#include "../include/Trace.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
 #include <thread>
 #include <iostream>
 
@@ -29,6 +34,7 @@ Controller::Controller(Config &config_, std::shared_ptr<MessageQueues> queuesHan
     : gameState(), messageQueues(std::move(queuesHandler_)), config(config_)
 {
     gameState.init();
+    legalMoves = LegalMoveSet(gameState);
     send_state();
 
     if (config.logPath.has_value()) {
@@ -45,6 +51,7 @@ void Controller::run()
 {
     while (has_human_player() || gameState.get_game_progress() == PLAYING)
     {
+        trace::Span span("controller_iteration");
         try_log_start_move();
 
         if (need_player_input())
@@ -56,17 +63,22 @@ void Controller::run()
                     return exit();
 
                 case SELECT:
-                    if (gameState.can_select_field(Coord(message.x, message.y))) {
+                    if (legalMoves.can_select_field(Coord(message.x, message.y))) {
                         selectedField = Coord(message.x, message.y);
                         // prevent second branch
-                    } else if (selectedField.has_value()) {
+                    } else if (selectedField.has_value()
+                               && legalMoves.can_move_piece(selectedField.value(), Coord(message.x, message.y))) {
+                        std::string moveText = move_text(selectedField.value(), Coord(message.x, message.y));
                         bool moved = gameState.try_make_move(selectedField.value(), Coord(message.x, message.y));
-                        if (moved && gameState.can_select_field(Coord(message.x, message.y))) {
+                        if (moved) {
+                            legalMoves = LegalMoveSet(gameState);
+                        }
+                        if (moved && legalMoves.can_select_field(Coord(message.x, message.y))) {
                             selectedField = Coord(message.x, message.y);
-                            try_log_end_move();
+                            try_log_end_move(moveText);
                         } else if (moved) {
                             selectedField = std::nullopt;
-                            try_log_end_move();
+                            try_log_end_move(moveText);
                         }
                     }
                     break;
@@ -76,21 +88,53 @@ void Controller::run()
         else
         {
             std::pair<Coord, Coord> move = std::make_pair(Coord(0,0), Coord(0,0));
+            auto moveStart = std::chrono::steady_clock::now();
+            memory::AllocationScope allocations;
+            std::function<void(const bot::SearchInfo &)> progress = nullptr;
+            if (config.showGUI && config.showStats) {
+                progress = [this](const bot::SearchInfo &info) { publish_search_progress(info); };
+            }
             switch(gameState.get_current_player()) {
                 case WHITE:
-                    move = bot::bot_move(gameState, WHITE, config.whiteBotHeuristic, config.whiteBotDepth);
+                    if (config.whiteSearch == ALPHA_BETA) {
+                        publish_search_start(config.whiteBotDepth);
+                        auto searched = search_move(config.whiteBotHeuristic, config.whiteBotDepth,
+                                                    config.whiteSearchFeatures, progress);
+                        if (!searched.has_value()) return exit();
+                        move = searched.value();
+                    } else {
+                        publish_search_start(0);
+                        move = bot::mcts_move(gameState, config.whiteBotHeuristic, config.whiteSearch, config.mcts,
+                                              progress);
+                    }
                     break;
                 case BLACK:
-                    move = bot::bot_move(gameState, BLACK, config.blackBotHeuristic, config.blackBotDepth);
+                    if (config.blackSearch == ALPHA_BETA) {
+                        publish_search_start(config.blackBotDepth);
+                        auto searched = search_move(config.blackBotHeuristic, config.blackBotDepth,
+                                                    config.blackSearchFeatures, progress);
+                        if (!searched.has_value()) return exit();
+                        move = searched.value();
+                    } else {
+                        publish_search_start(0);
+                        move = bot::mcts_move(gameState, config.blackBotHeuristic, config.blackSearch, config.mcts,
+                                              progress);
+                    }
                     break;
             }
+            publish_search_end(std::chrono::steady_clock::now() - moveStart);
+            memory::AllocationCounters moveAllocations = allocations.elapsed();
+            std::string moveText = move_text(move.first, move.second);
             if (!gameState.try_make_move(move.first, move.second)) {
-             std::cerr << "Bot tried to make illegal move!" << " "  << gameState.get_current_player()
+             std::cerr << "Bot tried to make illegal move!" << " "  << static_cast<int>(gameState.get_current_player())
                 << "x: " << move.second.x << "y: " << move.second.y << std::endl;
             }
-            try_log_end_move();
+            legalMoves = LegalMoveSet(gameState);
+            try_log_end_move(moveText);
+            try_log_memory(moveAllocations);
 
             if (config.showGUI) {
+                trace::Span sleepSpan("controller_sleep");
                 std::this_thread::sleep_for(std::chrono::milliseconds(250));
             }
             send_state();
@@ -120,6 +164,41 @@ PlayerInputMessage Controller::get_player_input()
     return messageQueues->wait_for_player_input();
 }
 
+/**
+ * @brief Wybierz ruch bota przeszukiwaniem alpha-beta (jak bot::bot_move).
+ * @details Przeszukiwanie wykonywane jest krokami po CONTROLLER_SEARCH_SLICE, a pomiędzy nimi
+ *          kontroler odbiera akcje gracza, więc zamknięcie okna przerywa ruch bota. Kliknięcia
+ *          planszy w trakcie ruchu bota są pomijane.
+ *
+ * @param heuristic - heurystyka bota.
+ * @param depth - głębokość przeszukiwania.
+ * @param features - techniki przeszukiwania selektywnego.
+ * @param progress - opcjonalna funkcja wywoływana z postępem przeszukiwania.
+ * @return std::optional<std::pair<Coord, Coord>> - ruch bota lub nullopt jeśli gracz zakończył grę.
+ */
+std::optional<std::pair<Coord, Coord>> Controller::search_move(HeuristicEnum heuristic, int depth,
+                                                               const SearchFeatures &features,
+                                                               const std::function<void(const bot::SearchInfo &)> &progress)
+{
+    trace::Span span("bot_move", depth);
+    bot::SearchLimits limits;
+    limits.depth = depth;
+    limits.features = features;
+    bot::Search search(heuristic);
+    search.set_progress_callback(progress);
+    search.start(gameState, limits);
+    while (!search.step(CONTROLLER_SEARCH_SLICE)) {
+        while (auto message = messageQueues->check_for_player_input()) {
+            if (message.value().messageType == EXIT) return std::nullopt;
+        }
+    }
+    std::vector<bot::RootMove> best = search.get_best();
+    if (best.empty()) {
+        return std::make_pair(Coord(0,0), Coord(0,0));
+    }
+    return std::make_pair(to_coord(best.front().move.from), to_coord(best.front().move.to));
+}
+
 /**
  * @brief Czy ruch ma wykonać gracz który nie jest botem.
  * 
@@ -140,12 +219,81 @@ bool Controller::need_player_input() const
 void Controller::send_state() const
 {
     if (config.showGUI) {
+        trace::Span span("send_state");
         messageQueues->send_game_state(
-                GameStateMessage(gameState.get_game_progress(), gameState.get_board_state(), selectedField)
+                GameStateMessage(gameState.get_game_progress(), gameState.get_board_state(), selectedField, legalMoves)
         );
     }
 }
 
+/**
+ * @brief Wyślij do widoku statystyki rozpoczynanego przeszukiwania.
+ *
+ * @param maxDepth - docelowa głębokość przeszukiwania lub 0 dla Monte Carlo Tree Search.
+ */
+void Controller::publish_search_start(int maxDepth)
+{
+    if (!config.showGUI || !config.showStats) return;
+    stats.player = gameState.get_current_player();
+    stats.searching = true;
+    stats.depth = 0;
+    stats.maxDepth = maxDepth;
+    stats.score = 0;
+    stats.nodes = 0;
+    stats.elapsedMs = 0;
+    stats.evalHitRate = 0;
+    stats.evalSavedMs = 0;
+    stats.remainingMs = maxDepth == 0 && config.mcts.time.has_value() ? config.mcts.time.value() : -1;
+    stats.pv[0] = '\0';
+    messageQueues->publish_stats(stats);
+}
+
+/**
+ * @brief Wyślij do widoku postęp przeszukiwania bota.
+ *
+ * @param info - raport postępu przeszukiwania.
+ */
+void Controller::publish_search_progress(const bot::SearchInfo &info)
+{
+    stats.depth = info.depth;
+    stats.nodes = info.nodes;
+    stats.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(info.time).count();
+    if (stats.remainingMs >= 0) {
+        stats.remainingMs = std::max<std::int64_t>(0, config.mcts.time.value_or(0) - stats.elapsedMs);
+    }
+    stats.evalHitRate = info.evalCache.hit_rate();
+    stats.evalSavedMs = std::chrono::duration_cast<std::chrono::milliseconds>(info.evalCache.saved).count();
+    if (!info.lines.empty()) {
+        stats.score = info.lines.front().score;
+        std::string pv;
+        GameState pvState = gameState;
+        for (auto move : info.lines.front().pv) {
+            std::string text = move_to_string(pvState, move);
+            if (pv.size() + text.size() + 1 >= STATS_PV_CHARS) break;
+            pv += (pv.empty() ? "" : " ") + text;
+            pvState.try_make_move(move);
+        }
+        std::snprintf(stats.pv, STATS_PV_CHARS, "%s", pv.c_str());
+    }
+    messageQueues->publish_stats(stats);
+}
+
+/**
+ * @brief Wyślij do widoku statystyki zakończonego przeszukiwania wraz z czasem ruchu.
+ *
+ * @param latency - czas wyboru ruchu przez bota.
+ */
+void Controller::publish_search_end(std::chrono::steady_clock::duration latency)
+{
+    if (!config.showGUI || !config.showStats) return;
+    auto milliseconds = std::chrono::duration_cast<std::chrono::microseconds>(latency).count() / 1000.0f;
+    stats.searching = false;
+    stats.remainingMs = -1;
+    stats.latenciesMs[stats.latencyCount % STATS_LATENCY_HISTORY] = milliseconds;
+    ++stats.latencyCount;
+    messageQueues->publish_stats(stats);
+}
+
 /**
  * @brief Zakończ pracę kontrolera, zapisz stan gry jeśli była w trakcie.
  *
@@ -170,6 +318,10 @@ void Controller::try_log_start_game() {
                 logFile.value() << "basic ";
             } else if (config.whiteBotHeuristic == A_BASIC) {
                 logFile.value() << "a_basic ";
+            } else if (config.whiteBotHeuristic == NNUE) {
+                logFile.value() << "nnue ";
+            } else if (config.whiteBotHeuristic == PATTERN) {
+                logFile.value() << "pattern ";
             } else {
                 logFile.value() << "board_aware ";
             }
@@ -190,6 +342,10 @@ void Controller::try_log_start_game() {
                 logFile.value() << "basic ";
             } else if (config.blackBotHeuristic == A_BASIC) {
                 logFile.value() << "a_basic ";
+            } else if (config.blackBotHeuristic == NNUE) {
+                logFile.value() << "nnue ";
+            } else if (config.blackBotHeuristic == PATTERN) {
+                logFile.value() << "pattern ";
             } else {
                 logFile.value() << "board_aware ";
             }
@@ -220,16 +376,45 @@ void Controller::try_log_start_move() {
 
 /**
  * @brief Spróbuj zapisać do logu informację o zakończeniu ruchu..
+ * @details Po czasie ruchu zapisywany jest sam ruch, co pozwala odtworzyć partię z logu (--replay).
  *
+ * @param move - ruch w zapisie notacji.
  */
-void Controller::try_log_end_move() {
+void Controller::try_log_end_move(const std::string &move) {
     if (logFile.has_value()) {
         auto now = std::chrono::steady_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(now - lastMoveStart.value()).count();
-        logFile.value() << duration << std::endl;
+        logFile.value() << duration << " " << move << std::endl;
     }
 }
 
+/**
+ * @brief Spróbuj zapisać do logu alokacje i pamięć zajętą przez ruch bota.
+ * @details Zapisywane w osobnej linii "memory (alokacje) (bajty) (VmRSS kB) (VmHWM kB)",
+ *          którą pomijają skrypty czytające czasy ruchów i odtwarzanie partii.
+ *
+ * @param allocations - alokacje wątku kontrolera w trakcie wyboru ruchu.
+ */
+void Controller::try_log_memory(const memory::AllocationCounters &allocations) {
+    if (logFile.has_value() && config.memoryStats) {
+        memory::ResidentMemory resident = memory::read_resident_memory().value_or(memory::ResidentMemory());
+        logFile.value() << "memory " << allocations.allocations << " " << allocations.bytes << " "
+                        << resident.residentKb << " " << resident.peakResidentKb << std::endl;
+    }
+}
+
+/**
+ * @brief Zapis ruchu w obecnym stanie gry, przed jego wykonaniem.
+ *
+ * @param from - pole, z którego rusza się bierka.
+ * @param to - pole docelowe.
+ * @return std::string - ruch w zapisie notacji lub "?" dla pól spoza planszy.
+ */
+std::string Controller::move_text(Coord from, Coord to) const {
+    if (!is_playable(from) || !is_playable(to)) return "?";
+    return move_to_string(gameState, Move{to_square(from), to_square(to)});
+}
+
 
 /**
  * @brief Spróbuj zapisać do logu wynik rozgrywki.
@@ -0,0 +1,106 @@
+/**
+ * @file Endgame.cpp
+ * @author Bartosz Świrta
+ * @brief Zawiera definicję rozpoznawania końcówek o znanym wyniku.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "../include/Endgame.hpp"
+#include "../include/BotMove.hpp"
+
+using namespace checkers;
+using namespace checkers::bot;
+
+namespace
+{
+    using Mask = GameState::Mask;
+    using Layout = GameState::Board::Layout;
+
+    /// Maska pól głównej przekątnej a1-h8.
+    constexpr Mask main_diagonal()
+    {
+        Mask mask = 0;
+        for (int i = 0; i < Layout::BOARD_SIZE; ++i) {
+            mask |= Mask(1) << Layout::to_square(i, i);
+        }
+        return mask;
+    }
+
+    constexpr Mask MAIN_DIAGONAL = main_diagonal();
+
+    int count(Mask mask)
+    {
+        int result = 0;
+        for (; mask; mask &= mask - 1) {
+            ++result;
+        }
+        return result;
+    }
+
+    /// Wygrana podanego gracza z przewagą materialną w wagach basic_heuristic.
+    EndgameScore win(PlayerEnum player, int material)
+    {
+        return player == WHITE ? EndgameScore{ENDGAME_WIN + material, ENDGAME_LOWER}
+                               : EndgameScore{-ENDGAME_WIN + material, ENDGAME_UPPER};
+    }
+} // namespace
+
+std::optional<EndgameScore> checkers::bot::recognize_endgame(const GameState &gameState)
+{
+    if (gameState.get_game_progress() != PLAYING || gameState.must_capture()) return std::nullopt;
+
+    Mask queens = gameState.get_queens();
+    Mask white = gameState.get_pieces(WHITE);
+    Mask black = gameState.get_pieces(BLACK);
+    int whiteQueens = count(white & queens);
+    int blackQueens = count(black & queens);
+    int whitePawns = count(white & ~queens);
+    int blackPawns = count(black & ~queens);
+    int material = basicHeuristicTable[1] * whiteQueens + basicHeuristicTable[0] * whitePawns
+                   - (basicHeuristicTable[3] * blackQueens + basicHeuristicTable[2] * blackPawns);
+
+    if (whitePawns == 0 && blackPawns == 0) {
+        PlayerEnum current = gameState.get_current_player();
+        PlayerEnum strong = whiteQueens == blackQueens ? (current == WHITE ? BLACK : WHITE)
+                          : whiteQueens > blackQueens ? WHITE : BLACK;
+        Mask strongQueens = strong == WHITE ? white : black;
+        Mask loneQueen = strong == WHITE ? black : white;
+        int strongCount = count(strongQueens);
+        if (count(loneQueen) != 1) return std::nullopt;
+
+        // Remis tylko gdy samotna królowa ma ruch i dość pól do ucieczki - w rogu można ją złapać.
+        bool canEscape = current != strong
+                         && gameState.legal_moves().size() >= ENDGAME_ESCAPE_MOVES;
+        if (strongCount <= 2) {
+            if (canEscape) return EndgameScore{0, ENDGAME_EXACT};
+            return std::nullopt;
+        }
+        if (strongCount == 3) {
+            // Królowa na głównej przekątnej nie daje się z niej wyprzeć, a bez niej nie da się złapać samotnej królowej.
+            if ((loneQueen & MAIN_DIAGONAL) && !(strongQueens & MAIN_DIAGONAL)) {
+                if (canEscape) return EndgameScore{0, ENDGAME_EXACT};
+                return std::nullopt;
+            }
+            if ((strongQueens & MAIN_DIAGONAL) && !(loneQueen & MAIN_DIAGONAL)
+                && gameState.get_reversible_moves() < ENDGAME_QUEENS_WIN_TURNS) {
+                return win(strong, material);
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Królowa z dużą przewagą liczebną przeciwko samym pionom.
+    int whiteCount = whiteQueens + whitePawns;
+    int blackCount = blackQueens + blackPawns;
+    if (blackQueens == 0 && whiteQueens > 0 && whiteCount >= blackCount + ENDGAME_OVERWHELMING_LEAD) {
+        return win(WHITE, material);
+    }
+    if (whiteQueens == 0 && blackQueens > 0 && blackCount >= whiteCount + ENDGAME_OVERWHELMING_LEAD) {
+        return win(BLACK, material);
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,263 @@
+/**
+ * @file Engine.cpp
+ * @author Bartosz Świrta
+ * @brief Zawiera definicję metod klasy Engine.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "../include/Engine.hpp"
+#include "../include/Notation.hpp"
+#include "../include/Trace.hpp"
+
+#include <cmath>
+#include <algorithm>
+#include <iostream>
+
+using namespace checkers;
+
+/**
+ * @brief Konstruktor silnika z ustawieniami białego komputera z podanej konfiguracji.
+ *
+ * @param config_ - struktura przechowująca dane konfiguracyjne.
+ */
+Engine::Engine(const Config &config_)
+    : heuristicType(config_.whiteBotHeuristic), features(config_.whiteSearchFeatures),
+      search(std::make_unique<bot::Search>(heuristicType))
+{
+    gameState.init();
+}
+
+Engine::~Engine()
+{
+    stop();
+}
+
+/**
+ * @brief Uruchamia pętlę obsługi poleceń.
+ * @details Polecenia czytane są linia po linii ze standardowego wejścia. Przeszukiwanie działa
+ *          w osobnym wątku, więc w jego trakcie można wysłać stop.
+ *
+ */
+void Engine::run()
+{
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        std::istringstream args(line);
+        std::string command;
+        args >> command;
+
+        if (command.empty()) {
+            continue;
+        } else if (command == "isready") {
+            send("readyok");
+        } else if (command == "newgame") {
+            stop();
+            gameState = GameState();
+            gameState.init();
+        } else if (command == "position") {
+            stop();
+            set_position(args);
+        } else if (command == "setoption") {
+            stop();
+            set_option(args);
+        } else if (command == "go") {
+            stop();
+            go(args);
+        } else if (command == "stop") {
+            stop();
+        } else if (command == "quit") {
+            break;
+        } else {
+            send("info string unknown command " + command);
+        }
+    }
+    stop();
+}
+
+/**
+ * @brief Obsługa polecenia position.
+ *
+ * @param args - "startpos" lub "fen" z zapisem pozycji, oraz opcjonalnie "moves" i lista ruchów.
+ */
+void Engine::set_position(std::istringstream &args)
+{
+    // Pozycja jest budowana osobno, żeby błędny ruch nie zostawił jej w połowie ustawionej.
+    GameState position;
+    std::string token;
+    args >> token;
+    if (token == "startpos") {
+        position.init();
+    } else if (token == "fen") {
+        std::string rows, player, chain;
+        args >> rows >> player >> chain;
+        auto parsed = GameState::try_from_string(rows + " " + player + " " + chain);
+        if (!parsed.has_value()) {
+            send("info string malformed position " + rows + " " + player + " " + chain);
+            return;
+        }
+        position = parsed.value();
+    } else {
+        send("info string unknown position " + token);
+        return;
+    }
+
+    if (args >> token && token == "moves") {
+        while (args >> token) {
+            auto move = move_from_string(token);
+            if (!move.has_value() || !position.try_make_move(move.value())) {
+                send("info string illegal move " + token);
+                return;
+            }
+        }
+    }
+    gameState = position;
+}
+
+/**
+ * @brief Obsługa polecenia setoption.
+ *
+ * @param args - "name (heuristic|multipv|lmr|futility|extensions|endgame) value (wartość)".
+ */
+void Engine::set_option(std::istringstream &args)
+{
+    std::string nameToken, name, valueToken, value;
+    args >> nameToken >> name >> valueToken >> value;
+    if (nameToken != "name" || valueToken != "value") {
+        send("info string malformed setoption");
+    } else if (name == "heuristic") {
+        auto heuristic = heuristic_from_string(value);
+        if (!heuristic.has_value()) {
+            send("info string unknown heuristic " + value);
+            return;
+        }
+        heuristicType = heuristic.value();
+        search = std::make_unique<bot::Search>(heuristicType);
+    } else if (name == "multipv") {
+        try {
+            multiPv = std::max(1, std::stoi(value));
+        } catch (std::exception &) {
+            send("info string malformed multipv " + value);
+        }
+    } else if (name == "lmr" || name == "futility" || name == "extensions"
+               || name == "endgame") {
+        if (value != "true" && value != "false") {
+            send("info string malformed " + name + " " + value);
+            return;
+        }
+        bool &feature = name == "lmr" ? features.lateMoveReductions
+                      : name == "futility" ? features.futilityPruning
+                      : name == "extensions" ? features.captureExtensions
+                      : features.endgameKnowledge;
+        feature = value == "true";
+    } else {
+        send("info string unknown option " + name);
+    }
+}
+
+/**
+ * @brief Obsługa polecenia go, uruchamia przeszukiwanie w osobnym wątku.
+ *
+ * @param args - limity przeszukiwania; bez limitów przeszukiwanie trwa do polecenia stop.
+ */
+void Engine::go(std::istringstream &args)
+{
+    bot::SearchLimits limits;
+    limits.depth = bot::MAX_PLY;
+    limits.multiPv = multiPv;
+    limits.features = features;
+    limits.stop = &stopSignal;
+
+    std::string token;
+    try {
+        while (args >> token) {
+            std::string value;
+            if (token == "depth" && args >> value) {
+                limits.depth = std::stoi(value);
+            } else if (token == "movetime" && args >> value) {
+                limits.time = std::chrono::milliseconds(std::stoll(value));
+            } else if (token == "nodes" && args >> value) {
+                limits.nodes = std::stoull(value);
+            } else if (token != "infinite") {
+                send("info string unknown go parameter " + token);
+                return;
+            }
+        }
+    } catch (std::exception &) {
+        send("info string malformed go parameter " + token);
+        return;
+    }
+
+    GameState root = gameState;
+    stopSignal = false;
+    search->set_iteration_callback([this, root](const bot::SearchInfo &info) {
+        send_info(root, info);
+    });
+    searchThread = std::thread([this, root, limits]() {
+        trace::set_thread_name("search");
+        std::vector<bot::RootMove> best = search->run(root, limits);
+        if (best.empty()) {
+            send("bestmove none");
+        } else {
+            send("bestmove " + move_to_string(root, best.front().move));
+        }
+    });
+}
+
+/**
+ * @brief Przerywa trwające przeszukiwanie i czeka na jego zakończenie.
+ *
+ */
+void Engine::stop()
+{
+    if (searchThread.joinable()) {
+        stopSignal = true;
+        searchThread.join();
+    }
+}
+
+/**
+ * @brief Wypisuje linie info z podsumowaniem iteracji, po jednej dla każdego analizowanego ruchu.
+ *
+ * @param root - pozycja w korzeniu przeszukiwania.
+ * @param info - podsumowanie ukończonej iteracji.
+ */
+void Engine::send_info(const GameState &root, const bot::SearchInfo &info)
+{
+    long long micros = std::max<long long>(1, info.time.count());
+    long long nps = static_cast<long long>(info.nodes * 1000000 / micros);
+    int sign = root.get_current_player() == WHITE ? 1 : -1;
+
+    for (size_t i = 0; i < info.lines.size(); ++i) {
+        std::ostringstream out;
+        out << "info depth " << info.depth
+            << " multipv " << i + 1
+            << " score " << sign * info.lines[i].score
+            << " nodes " << info.nodes
+            << " nps " << nps
+            << " time " << micros / 1000
+            << " evalhits " << std::llround(info.evalCache.hit_rate())
+            << " evalsaved " << info.evalCache.saved.count() / 1000
+            << " pv";
+        GameState state = root;
+        for (auto move : info.lines[i].pv) {
+            out << " " << move_to_string(state, move);
+            state.try_make_move(move);
+        }
+        send(out.str());
+    }
+}
+
+/**
+ * @brief Wypisuje jedną linię odpowiedzi.
+ *
+ * @param line - treść linii.
+ */
+void Engine::send(const std::string &line)
+{
+    std::lock_guard<std::mutex> lg(outputMutex);
+    std::cout << line << std::endl;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file EvalCache.cpp
+ * @author Bartosz Świrta
+ * @brief Zawiera definicję metod klasy EvalCache.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "../include/EvalCache.hpp"
+
+using namespace checkers;
+using namespace checkers::bot;
+
+namespace
+{
+    std::size_t entry_index(std::uint64_t hash)
+    {
+        return static_cast<std::size_t>(hash) & (EVAL_CACHE_ENTRIES - 1);
+    }
+
+    /// Starsza połowa skrótu sprawdzana przy odczycie. Najmłodszy bit odróżnia ją od pustego miejsca.
+    std::uint64_t slot_check(std::uint64_t hash)
+    {
+        return (hash | (std::uint64_t(1) << 32)) & ~std::uint64_t(0xFFFFFFFF);
+    }
+} // namespace
+
+double EvalCacheStats::hit_rate() const
+{
+    return probes == 0 ? 0.0 : 100.0 * static_cast<double>(hits) / static_cast<double>(probes);
+}
+
+EvalCache::EvalCache()
+    : entries(new Entry[EVAL_CACHE_ENTRIES])
+{
+    // Domyślnie utworzone std::atomic mają nieokreśloną wartość, a probe odczytuje każde słowo.
+    clear();
+}
+
+std::optional<int> EvalCache::probe(std::uint64_t hash, HeuristicEnum heuristicType) const
+{
+    std::uint64_t slot = entries[entry_index(hash)].slots[heuristicType].load(std::memory_order_relaxed);
+    if ((slot & ~std::uint64_t(0xFFFFFFFF)) != slot_check(hash)) return std::nullopt;
+    return static_cast<int>(static_cast<std::int32_t>(static_cast<std::uint32_t>(slot)));
+}
+
+void EvalCache::store(std::uint64_t hash, HeuristicEnum heuristicType, int score)
+{
+    std::uint64_t slot = slot_check(hash) | static_cast<std::uint32_t>(score);
+    entries[entry_index(hash)].slots[heuristicType].store(slot, std::memory_order_relaxed);
+}
+
+void EvalCache::clear()
+{
+    for (std::size_t i = 0; i < EVAL_CACHE_ENTRIES; ++i) {
+        for (auto &slot : entries[i].slots) {
+            slot.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+EvalCache &checkers::bot::shared_eval_cache()
+{
+    static EvalCache cache;
+    return cache;
+}
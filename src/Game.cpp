@@ -11,353 +11,655 @@
 
 #include "../include/Game.hpp"
 
+#include <algorithm>
+#include <sstream>
+
 using namespace checkers;
 
-void GameState::init() {
-    for (size_t x = 0; x < 8; ++x) {
-        for (size_t y = 0; y < 8; ++y) {
-            if ((x + y) % 2 == 0 && y < 3) {
-                board.fields[x][y] = WHITE_PAWN;
-            } 
-            else if ((x + y) % 2 == 0 && y > 4) {
-                board.fields[x][y] = BLACK_PAWN;
-            } 
-            else {
-                board.fields[x][y] = std::nullopt;
-            }
+namespace
+{
+    /// 32-bitowy odcisk układu bierek (bez gracza wykonującego ruch), używany do wykrywania powtórzeń.
+    std::uint32_t board_fingerprint(std::uint32_t white, std::uint32_t black, std::uint32_t queens)
+    {
+        std::uint64_t hash = (static_cast<std::uint64_t>(white) << 32 | black) * 0x9E3779B97F4A7C15ull;
+        hash ^= (hash >> 29) ^ queens * 0xC2B2AE3D27D4EB4Full;
+        hash *= 0xBF58476D1CE4E5B9ull;
+        hash ^= hash >> 32;
+        return static_cast<std::uint32_t>(hash);
+    }
+
+    /// Odcisk układu bierek na planszy większej niż 32 pola.
+    std::uint32_t board_fingerprint(std::uint64_t white, std::uint64_t black, std::uint64_t queens)
+    {
+        std::uint64_t hash = white * 0x9E3779B97F4A7C15ull;
+        hash = (hash ^ (hash >> 31) ^ black) * 0xBF58476D1CE4E5B9ull;
+        hash = (hash ^ (hash >> 29) ^ queens) * 0x94D049BB133111EBull;
+        hash ^= hash >> 32;
+        return static_cast<std::uint32_t>(hash);
+    }
+
+    /// 64-bitowy skrót układu bierek i gracza wykonującego ruch, używany jako klucz tablic ocen.
+    std::uint64_t position_hash(std::uint64_t white, std::uint64_t black, std::uint64_t queens, bool whiteToMove)
+    {
+        std::uint64_t hash = white * 0x9E3779B97F4A7C15ull;
+        hash = (hash ^ (hash >> 31) ^ black) * 0xBF58476D1CE4E5B9ull;
+        hash = (hash ^ (hash >> 29) ^ queens) * 0x94D049BB133111EBull;
+        hash = (hash ^ (hash >> 32) ^ static_cast<std::uint64_t>(whiteToMove)) * 0xD6E8FEB86659FD93ull;
+        return hash ^ (hash >> 32);
+    }
+
+    /// Zapis pola w notacji szachowej dla planszy dowolnego rozmiaru (na planszy 8x8 jak square_to_string).
+    template<class Board>
+    std::string square_name(Square square)
+    {
+        return static_cast<char>('a' + Board::square_x(square)) + std::to_string(Board::square_y(square) + 1);
+    }
+
+    template<class Board>
+    std::optional<Square> square_from_name(const std::string &text)
+    {
+        if (text.size() < 2 || text[0] < 'a' || text[1] < '1' || text[1] > '9') return std::nullopt;
+        if (text.find_first_not_of("0123456789", 1) != std::string::npos) return std::nullopt;
+        int x = text[0] - 'a';
+        int y = std::stoi(text.substr(1)) - 1;
+        if (!Board::is_playable(x, y)) return std::nullopt;
+        return Board::to_square(x, y);
+    }
+} // namespace
+
+template<class Rules>
+void BasicGameState<Rules>::init() {
+    white = 0;
+    black = 0;
+    queens = 0;
+    captured = 0;
+    for (Square square = 0; square < Board::SQUARES; ++square) {
+        if (Board::square_y(square) < Rules::PAWN_ROWS) {
+            white |= Board::square_mask(square);
+        }
+        else if (Board::square_y(square) >= Board::BOARD_SIZE - Rules::PAWN_ROWS) {
+            black |= Board::square_mask(square);
         }
     }
     gameProgress = PLAYING;
-    currentPlayer = WHITE;
-    lastMove = std::nullopt;
+    currentPlayer = Rules::WHITE_STARTS ? WHITE : BLACK;
+    lastMove = NO_SQUARE;
+    queenMovesNoTake = 0;
+    historyCount = 0;
+    update_attackers();
 }
 
-BoardState GameState::get_board_state() const {
-    return board;
+template<class Rules>
+auto BasicGameState<Rules>::get_board_state() const -> BasicBoardState<Board::BOARD_SIZE> {
+    BasicBoardState<Board::BOARD_SIZE> state;
+    for (Square square = 0; square < Board::SQUARES; ++square) {
+        state.fields[Board::square_x(square)][Board::square_y(square)] = get_square(square);
+    }
+    return state;
 }
 
-PlayerEnum GameState::get_current_player() const {
+template<class Rules>
+PlayerEnum BasicGameState<Rules>::get_current_player() const {
     return currentPlayer;
 }
 
-GameProgressEnum GameState::get_game_progress() const {
+template<class Rules>
+GameProgressEnum BasicGameState<Rules>::get_game_progress() const {
     return gameProgress;
 }
 
-std::optional<PieceEnum> GameState::get_field(Coord field) const {
-    return board.fields[field.x][field.y];
+template<class Rules>
+std::optional<PieceEnum> BasicGameState<Rules>::get_field(Coord field) const {
+    if (!Board::is_playable(field.x, field.y)) return std::nullopt;
+    return get_square(Board::to_square(field.x, field.y));
+}
+
+template<class Rules>
+std::optional<PieceEnum> BasicGameState<Rules>::get_square(Square square) const {
+    Mask mask = Board::square_mask(square);
+    bool queen = queens & mask;
+    if (white & mask) return queen ? WHITE_QUEEN : WHITE_PAWN;
+    if (black & mask) return queen ? BLACK_QUEEN : BLACK_PAWN;
+    return std::nullopt;
 }
 
-bool GameState::can_select_field(Coord field) const {
-    if (lastMove.has_value() && lastMove.value() != field) return false;
-    if (!is_current_player_piece(field)) return false;
-    if (piece_moves(field).size() == 0) return false;
-    if (count_pieces_with_attack() > 0 && !piece_has_attacks(field)) return false;
+template<class Rules>
+bool BasicGameState<Rules>::can_select_field(Coord field) const {
+    if (!Board::is_playable(field.x, field.y)) return false;
+    Square square = Board::to_square(field.x, field.y);
+    if (lastMove != NO_SQUARE && lastMove != square) return false;
+    if (!is_current_player_piece(square)) return false;
+    MoveListType moves;
+    append_piece_moves(square, moves);
+    if (moves.empty()) return false;
+    if (attackers != 0 && !(attackers & Board::square_mask(square))) return false;
     return true;
 }
 
-bool GameState::try_make_move(Coord from, Coord to) {
-    if (can_move_piece(from, to)) {
-        move_piece(from, to);
-        lastMove = to;
+template<class Rules>
+bool BasicGameState<Rules>::try_make_move(Coord from, Coord to) {
+    if (!Board::is_playable(from.x, from.y) || !Board::is_playable(to.x, to.y)) return false;
+    return try_make_move(Move{Board::to_square(from.x, from.y), Board::to_square(to.x, to.y)});
+}
 
-        bool attacked = false;
-        if (!is_empty_between(from, to)) {
-            attacked = true;
-            clear_between(from, to);
-        }
+template<class Rules>
+bool BasicGameState<Rules>::try_make_move(Move move) {
+    return currentPlayer == WHITE ? try_make_move<WHITE>(move) : try_make_move<BLACK>(move);
+}
 
-        if (to.y == 7 && currentPlayer == WHITE && get_field(to).value() == WHITE_PAWN) {
-            set_field(to, WHITE_QUEEN);
-        } else if (to.y == 0 && currentPlayer == BLACK && get_field(to).value() == BLACK_PAWN) {
-            set_field(to, BLACK_QUEEN);
-        }
+template<class Rules>
+template<PlayerEnum Side>
+bool BasicGameState<Rules>::try_make_move(Move move) {
+    Square from = move.from;
+    Square to = move.to;
+    if (!can_move_piece<Side>(from, to)) return false;
 
-        if (!attacked || !piece_has_attacks(to)) {
-            flip_current_player();
-            update_tie_conditions(
-                    attacked
-                    || lastMove.has_value()
-                    || get_field(to).value() == WHITE_PAWN
-                    || get_field(to).value() == BLACK_PAWN);
-        }
-        update_game_progress();
-        return true;
+    bool attacked = !is_empty_between(from, to);
+    if (make_step<Side>(from, to)) {
+        update_attackers<Side>();
     } else {
-        return false;
+        if constexpr (Rules::PROMOTION == PROMOTE_AT_TURN_END) {
+            if (Board::square_y(to) == SideTraits<Side>::template promotion_row<Board>()) {
+                queens |= Board::square_mask(to);
+            }
+        }
+        if constexpr (Rules::REMOVE_CAPTURED_AT_END) {
+            white &= ~captured;
+            black &= ~captured;
+            queens &= ~captured;
+            captured = 0;
+        }
+        flip_current_player();
+        update_tie_conditions(attacked || !(queens & Board::square_mask(to)));
+        update_attackers<SideTraits<Side>::ENEMY>();
     }
+    update_game_progress();
+    return true;
+}
+
+template<class Rules>
+std::optional<Coord> BasicGameState<Rules>::get_last_move() const {
+    if (lastMove == NO_SQUARE) return std::nullopt;
+    return Coord(Board::square_x(lastMove), Board::square_y(lastMove));
+}
+
+template<class Rules>
+bool BasicGameState<Rules>::can_move_piece(Coord from, Coord to) const {
+    if (!Board::is_playable(from.x, from.y) || !Board::is_playable(to.x, to.y)) return false;
+    return can_move_piece(Board::to_square(from.x, from.y), Board::to_square(to.x, to.y));
 }
 
-std::optional<Coord> GameState::get_last_move() const {
-    return lastMove;
+template<class Rules>
+bool BasicGameState<Rules>::can_move_piece(Square from, Square to) const {
+    return currentPlayer == WHITE ? can_move_piece<WHITE>(from, to) : can_move_piece<BLACK>(from, to);
 }
 
-bool GameState::can_move_piece(Coord from, Coord to) const {
-    if (!can_move_piece_relaxed(from, to)) return false;
-    int attacking = count_pieces_with_attack();
-    if (attacking > 0 && !piece_has_attacks(from)) return false;
-    if (piece_has_attacks(from) && is_empty_between(from, to)) return false;
+template<class Rules>
+template<PlayerEnum Side>
+bool BasicGameState<Rules>::can_move_piece(Square from, Square to) const {
+    if (!can_move_piece_relaxed<Side>(from, to)) return false;
+    bool hasAttacks = attackers & Board::square_mask(from);
+    if (attackers != 0 && !hasAttacks) return false;
+    if (hasAttacks && is_empty_between(from, to)) return false;
+    if constexpr (Rules::MAXIMUM_CAPTURE) {
+        if (hasAttacks && capture_length<Side>(from, to) != maxCapture) return false;
+    }
     return true;
 }
 
-std::vector<Coord> GameState::pieces_with_moves() const {
+template<class Rules>
+std::uint32_t BasicGameState<Rules>::get_fingerprint() const {
+    return board_fingerprint(white, black, queens);
+}
+
+template<class Rules>
+std::uint64_t BasicGameState<Rules>::get_hash() const {
+    return position_hash(white, black, queens, currentPlayer == WHITE);
+}
+
+template<class Rules>
+auto BasicGameState<Rules>::get_pieces(PlayerEnum player) const -> Mask {
+    return player == WHITE ? white : black;
+}
+
+template<class Rules>
+auto BasicGameState<Rules>::get_queens() const -> Mask {
+    return queens;
+}
+
+template<class Rules>
+int BasicGameState<Rules>::get_reversible_moves() const {
+    return queenMovesNoTake;
+}
+
+template<class Rules>
+bool BasicGameState<Rules>::must_capture() const {
+    return attackers != 0;
+}
+
+template<class Rules>
+typename BasicGameState<Rules>::MoveListType BasicGameState<Rules>::legal_moves() const {
+    return currentPlayer == WHITE ? legal_moves<WHITE>() : legal_moves<BLACK>();
+}
+
+template<class Rules>
+template<PlayerEnum Side>
+typename BasicGameState<Rules>::MoveListType BasicGameState<Rules>::legal_moves() const {
+    MoveListType moves;
+    Mask pieces = attackers != 0 ? attackers : own_pieces<Side>();
+    for (Square square : Board::SCAN_ORDER) {
+        if (pieces & Board::square_mask(square)) {
+            append_piece_moves<Side>(square, moves);
+        }
+    }
+    return moves;
+}
+
+template<class Rules>
+std::vector<Coord> BasicGameState<Rules>::pieces_with_moves() const {
     std::vector<Coord> pieces;
-    for (int x = 0; x < 8; ++x) {
-        for (int y = 0; y < 8; ++y) {
-            if (piece_moves(Coord(x, y)).size() > 0) {
-                pieces.push_back(Coord(x, y));
-            }
+    Square last = NO_SQUARE;
+    for (auto move : legal_moves()) {
+        if (move.from != last) {
+            pieces.push_back(Coord(Board::square_x(move.from), Board::square_y(move.from)));
+            last = move.from;
         }
     }
     return pieces;
 }
 
-std::vector<Coord> GameState::piece_moves(Coord field) const {
+template<class Rules>
+std::vector<Coord> BasicGameState<Rules>::piece_moves(Coord field) const {
     std::vector<Coord> vec;
-    if (!get_field(field).has_value()) return vec;
+    if (!Board::is_playable(field.x, field.y)) return vec;
+    MoveListType moves;
+    append_piece_moves(Board::to_square(field.x, field.y), moves);
+    for (auto move : moves) {
+        vec.push_back(Coord(Board::square_x(move.to), Board::square_y(move.to)));
+    }
+    return vec;
+}
 
-    switch (get_field(field).value()) {
-        case WHITE_PAWN:
-            if (is_in_board(field.x - 1, field.y + 1) && can_move_piece(field, field + Coord(-1, 1))) {
-                vec.push_back(field + Coord(-1, 1));
-            }
-            if (is_in_board(field.x + 1, field.y + 1) && can_move_piece(field, field + Coord(1, 1))) {
-                vec.push_back(field + Coord(1, 1));
-            }
-            if (is_in_board(field.x - 2, field.y + 2) && can_move_piece(field, field + Coord(-2, 2))) {
-                vec.push_back(field + Coord(-2, 2));
-            }
-            if (is_in_board(field.x + 2, field.y + 2) && can_move_piece(field, field + Coord(2, 2))) {
-                vec.push_back(field + Coord(2, 2));
-            }
-            if (is_in_board(field.x - 2, field.y - 2) && can_move_piece(field, field + Coord(-2, -2))) {
-                vec.push_back(field + Coord(-2, -2));
-            }
-            if (is_in_board(field.x + 2, field.y - 2) && can_move_piece(field, field + Coord(2, -2))) {
-                vec.push_back(field + Coord(2, -2));
+template<class Rules>
+std::string BasicGameState<Rules>::to_string() const {
+    std::string text;
+    for (int y = Board::BOARD_SIZE - 1; y >= 0; --y) {
+        for (int i = 0; i < Board::ROW_SQUARES; ++i) {
+            auto piece = get_square(static_cast<Square>(y * Board::ROW_SQUARES + i));
+            if (!piece.has_value()) {
+                text.push_back('.');
+            } else if (piece == WHITE_PAWN) {
+                text.push_back('w');
+            } else if (piece == WHITE_QUEEN) {
+                text.push_back('W');
+            } else if (piece == BLACK_PAWN) {
+                text.push_back('b');
+            } else {
+                text.push_back('B');
             }
-            break;
+        }
+        if (y > 0) text.push_back('/');
+    }
+    text += currentPlayer == WHITE ? " w " : " b ";
+    text += lastMove != NO_SQUARE ? square_name<Board>(lastMove) : "-";
+    return text;
+}
 
-        case BLACK_PAWN:
-            if (is_in_board(field.x - 1, field.y - 1) && can_move_piece(field, field + Coord(-1, -1))) {
-                vec.push_back(field + Coord(-1, -1));
+template<class Rules>
+std::optional<BasicGameState<Rules>> BasicGameState<Rules>::try_from_string(const std::string &text) {
+    constexpr int SIZE = Board::BOARD_SIZE;
+    constexpr int ROW = Board::ROW_SQUARES;
+    std::istringstream in(text);
+    std::string rows, player, chain, rest;
+    if (!(in >> rows >> player >> chain) || in >> rest) return std::nullopt;
+    if (rows.size() != SIZE * (ROW + 1) - 1) return std::nullopt;
+
+    BasicGameState state;
+    for (int row = 0; row < SIZE; ++row) {
+        if (row > 0 && rows[row * (ROW + 1) - 1] != '/') return std::nullopt;
+        for (int i = 0; i < ROW; ++i) {
+            Square square = static_cast<Square>((SIZE - 1 - row) * ROW + i);
+            switch (rows[row * (ROW + 1) + i]) {
+                case '.': state.set_field(square, std::nullopt); break;
+                case 'w': state.set_field(square, WHITE_PAWN); break;
+                case 'W': state.set_field(square, WHITE_QUEEN); break;
+                case 'b': state.set_field(square, BLACK_PAWN); break;
+                case 'B': state.set_field(square, BLACK_QUEEN); break;
+                default: return std::nullopt;
             }
-            if (is_in_board(field.x + 1, field.y - 1) && can_move_piece(field, field + Coord(1, -1))) {
-                vec.push_back(field + Coord(1, -1));
+        }
+    }
+
+    if (player == "w") {
+        state.currentPlayer = WHITE;
+    } else if (player == "b") {
+        state.currentPlayer = BLACK;
+    } else {
+        return std::nullopt;
+    }
+
+    state.lastMove = NO_SQUARE;
+    state.update_attackers();
+    if (chain != "-") {
+        auto square = square_from_name<Board>(chain);
+        // Łańcuch bić może kontynuować tylko bierka obecnego gracza, która ma dostępne bicie.
+        if (!square.has_value() || !(state.attackers & Board::square_mask(square.value()))) return std::nullopt;
+        state.lastMove = square.value();
+        state.update_attackers();
+    }
+
+    state.gameProgress = PLAYING;
+    if (state.legal_moves().empty()) {
+        state.gameProgress = state.currentPlayer == WHITE ? BLACK_WON : WHITE_WON;
+    }
+    return state;
+}
+
+template<class Rules>
+void BasicGameState<Rules>::append_piece_moves(Square field, MoveListType &moves) const {
+    if (currentPlayer == WHITE) {
+        append_piece_moves<WHITE>(field, moves);
+    } else {
+        append_piece_moves<BLACK>(field, moves);
+    }
+}
+
+template<class Rules>
+template<PlayerEnum Side>
+void BasicGameState<Rules>::append_piece_moves(Square field, MoveListType &moves) const {
+    if (!(own_pieces<Side>() & Board::square_mask(field))) return;
+    if (lastMove != NO_SQUARE && lastMove != field) return;
+    bool hasAttacks = attackers & Board::square_mask(field);
+    if (!hasAttacks && attackers != 0) return;
+
+    if constexpr (Rules::MAXIMUM_CAPTURE) {
+        if (hasAttacks) {
+            MoveListType captures;
+            append_piece_targets<Side>(field, true, captures);
+            for (auto move : captures) {
+                if (capture_length<Side>(move.from, move.to) == maxCapture) moves.push_back(move);
             }
-            if (is_in_board(field.x - 2, field.y - 2) && can_move_piece(field, field + Coord(-2, -2))) {
-                vec.push_back(field + Coord(-2, -2));
+            return;
+        }
+    }
+    append_piece_targets<Side>(field, hasAttacks, moves);
+}
+
+template<class Rules>
+template<PlayerEnum Side>
+void BasicGameState<Rules>::append_piece_targets(Square field, bool hasAttacks, MoveListType &moves) const {
+    // Kolejność kierunków odpowiada dotychczasowej kolejności generowania ruchów.
+    constexpr int pawnJumps = Rules::PAWNS_CAPTURE_BACKWARDS ? 4 : 2;
+    Mask occupied = white | black;
+    Mask enemies = enemy_pieces<Side>();
+
+    if (!(queens & Board::square_mask(field))) {
+        if (!hasAttacks) {
+            for (DirectionEnum dir : SideTraits<Side>::STEPS) {
+                Square target = Board::NEIGHBOUR[field][dir];
+                if (target != NO_SQUARE && !(occupied & Board::square_mask(target))) {
+                    moves.push_back(Move{field, target});
+                }
             }
-            if (is_in_board(field.x + 2, field.y - 2) && can_move_piece(field, field + Coord(2, -2))) {
-                vec.push_back(field + Coord(2, -2));
+        }
+        for (int i = 0; i < pawnJumps; ++i) {
+            DirectionEnum dir = SideTraits<Side>::JUMPS[i];
+            Square target = Board::JUMP[field][dir];
+            if (target != NO_SQUARE && !(occupied & Board::square_mask(target))
+                && (enemies & Board::square_mask(Board::NEIGHBOUR[field][dir]))) {
+                moves.push_back(Move{field, target});
             }
-            if (is_in_board(field.x + 2, field.y + 2) && can_move_piece(field, field + Coord(2, 2))) {
-                vec.push_back(field + Coord(2, 2));
+        }
+        return;
+    }
+
+    // Bity maska odległości (bit i = pole i + 1 na promieniu), na które królowa może się ruszyć.
+    // Królowa, która nie lata, rusza się o jedno pole albo bije sąsiednią bierkę.
+    constexpr int reach = Rules::FLYING_QUEENS ? Board::MAX_RAY : 2;
+    unsigned targets[DIRECTIONS] = {0, 0, 0, 0};
+    for (int dir = 0; dir < DIRECTIONS; ++dir) {
+        bool jumped = false;
+        int length = std::min<int>(Board::RAY.length[field][dir], reach);
+        for (int i = 0; i < length; ++i) {
+            Square square = Board::RAY.squares[field][dir][i];
+            if (!(occupied & Board::square_mask(square))) {
+                if (!Rules::FLYING_QUEENS && i > 0 && !jumped) break;
+                if (jumped || !hasAttacks) targets[dir] |= 1u << i;
+            } else if (!jumped && (enemies & Board::square_mask(square))) {
+                jumped = true;
+            } else {
+                break;
             }
-            if (is_in_board(field.x - 2, field.y + 2) && can_move_piece(field, field + Coord(-2, 2))) {
-                vec.push_back(field + Coord(-2, 2));
+        }
+    }
+    for (int i = 0; i < reach; ++i) {
+        for (int dir = 0; dir < DIRECTIONS; ++dir) {
+            if (targets[dir] & (1u << i)) {
+                moves.push_back(Move{field, Board::RAY.squares[field][dir][i]});
             }
-            break;
+        }
+    }
+}
 
-        case WHITE_QUEEN:
-        case BLACK_QUEEN:
-            for (int dx = 1, dy = 1; dx < 8; ++dx, ++dy) {
-                if (is_in_board(field.x + dx, field.y + dy)
-                    && can_move_piece(field, field + Coord(dx, dy))) {
-                    vec.push_back(field + Coord(dx, dy));
-                }
-                if (is_in_board(field.x - dx, field.y + dy)
-                    && can_move_piece(field, field + Coord(-dx, dy))) {
-                    vec.push_back(field + Coord(-dx, dy));
-                }
-                if (is_in_board(field.x + dx, field.y - dy)
-                    && can_move_piece(field, field + Coord(dx, -dy))) {
-                    vec.push_back(field + Coord(dx, -dy));
-                }
-                if (is_in_board(field.x - dx, field.y - dy)
-                    && can_move_piece(field, field + Coord(-dx, -dy))) {    //can_move_piece(field, field - Coord(-dx, -dy)))
-                    vec.push_back(field + Coord(-dx, -dy));                     //vec.push_back(field + Coord(-dx, -dy))
-                }
-            }
+template<class Rules>
+void BasicGameState<Rules>::set_field(Square field, std::optional<PieceEnum> piece) {
+    Mask mask = Board::square_mask(field);
+    white &= ~mask;
+    black &= ~mask;
+    queens &= ~mask;
+    if (!piece.has_value()) return;
+    if (piece == WHITE_PAWN || piece == WHITE_QUEEN) {
+        white |= mask;
+    } else {
+        black |= mask;
+    }
+    if (piece == WHITE_QUEEN || piece == BLACK_QUEEN) {
+        queens |= mask;
     }
-    return vec;
 }
 
-void GameState::set_field(Coord field, std::optional<PieceEnum> piece) {
-    board.fields[field.x][field.y] = piece;
+template<class Rules>
+bool BasicGameState<Rules>::make_step(Square from, Square to) {
+    return currentPlayer == WHITE ? make_step<WHITE>(from, to) : make_step<BLACK>(from, to);
 }
 
-void GameState::move_piece(Coord src, Coord dst) {
-    auto piece = get_field(src);
+template<class Rules>
+template<PlayerEnum Side>
+bool BasicGameState<Rules>::make_step(Square from, Square to) {
+    bool attacked = !is_empty_between(from, to);
+    move_piece(from, to);
+    lastMove = to;
+    if (attacked) {
+        clear_between(from, to);
+    }
+
+    constexpr int lastRow = SideTraits<Side>::template promotion_row<Board>();
+    bool promotion = Board::square_y(to) == lastRow && !(queens & Board::square_mask(to));
+    if constexpr (Rules::PROMOTION == PROMOTE_AND_CONTINUE) {
+        if (promotion) queens |= Board::square_mask(to);
+    } else if constexpr (Rules::PROMOTION == PROMOTE_AND_STOP) {
+        if (promotion) {
+            queens |= Board::square_mask(to);
+            return false;
+        }
+    }
+    return attacked && piece_has_attacks<Side>(to);
+}
+
+template<class Rules>
+int BasicGameState<Rules>::longest_capture(Square field) const {
+    return currentPlayer == WHITE ? longest_capture<WHITE>(field) : longest_capture<BLACK>(field);
+}
+
+template<class Rules>
+template<PlayerEnum Side>
+int BasicGameState<Rules>::longest_capture(Square field) const {
+    MoveListType captures;
+    append_piece_targets<Side>(field, true, captures);
+    int longest = 0;
+    for (auto move : captures) {
+        longest = std::max(longest, capture_length<Side>(move.from, move.to));
+    }
+    return longest;
+}
+
+template<class Rules>
+int BasicGameState<Rules>::capture_length(Square from, Square to) const {
+    return currentPlayer == WHITE ? capture_length<WHITE>(from, to) : capture_length<BLACK>(from, to);
+}
+
+template<class Rules>
+template<PlayerEnum Side>
+int BasicGameState<Rules>::capture_length(Square from, Square to) const {
+    BasicGameState next = *this;
+    return next.make_step<Side>(from, to) ? 1 + next.longest_capture<Side>(to) : 1;
+}
+
+template<class Rules>
+void BasicGameState<Rules>::move_piece(Square src, Square dst) {
+    auto piece = get_square(src);
     set_field(src, std::nullopt);
     set_field(dst, piece);
 }
 
-void GameState::flip_current_player() {
+template<class Rules>
+void BasicGameState<Rules>::flip_current_player() {
     if (currentPlayer == WHITE) {
         currentPlayer = BLACK;
-    } 
+    }
     else {
         currentPlayer = WHITE;
     }
-    lastMove = std::nullopt;
+    lastMove = NO_SQUARE;
 }
 
-int GameState::count_pieces_with_attack() const {
-    int count = 0;
-    for (int x = 0; x < 8; ++x) {
-        for (int y = 0; y < 8; ++y) {
-            if (is_current_player_piece(Coord(x, y)) && piece_has_attacks(Coord(x, y))) {
-                ++count;
+template<class Rules>
+void BasicGameState<Rules>::update_attackers() {
+    if (currentPlayer == WHITE) {
+        update_attackers<WHITE>();
+    } else {
+        update_attackers<BLACK>();
+    }
+}
+
+template<class Rules>
+template<PlayerEnum Side>
+void BasicGameState<Rules>::update_attackers() {
+    attackers = 0;
+    // W trakcie łańcucha bić ruch ma tylko bierka, która go wykonuje.
+    Mask pieces = own_pieces<Side>();
+    if (lastMove != NO_SQUARE) pieces &= Board::square_mask(lastMove);
+    for (Square square = 0; square < Board::SQUARES; ++square) {
+        if ((pieces & Board::square_mask(square)) && piece_has_attacks<Side>(square)) {
+            attackers |= Board::square_mask(square);
+        }
+    }
+    if constexpr (Rules::MAXIMUM_CAPTURE) {
+        // Obowiązek bicia mają tylko bierki z najdłuższym łańcuchem bić.
+        maxCapture = 0;
+        Mask longest = 0;
+        for (Square square = 0; square < Board::SQUARES; ++square) {
+            if (!(attackers & Board::square_mask(square))) continue;
+            int length = longest_capture<Side>(square);
+            if (length > maxCapture) {
+                maxCapture = static_cast<std::uint8_t>(length);
+                longest = 0;
             }
+            if (length == maxCapture) longest |= Board::square_mask(square);
         }
+        attackers = longest;
     }
-    return count;
-}
-
-bool GameState::can_move_piece_relaxed(Coord from, Coord to) const {
-    if (!get_field(from).has_value()) return false;
-    if (get_field(to).has_value()) return false;
-    if (is_enemy_player_piece(from)) return false;
-    if (lastMove.has_value() && lastMove.value() != from) return false;
-
-    switch (get_field(from).value()) {
-        case WHITE_PAWN:
-            if (to != from + Coord(1, 1) && to != from + Coord(-1, 1)
-                && to != from + Coord(2, 2) && to != from + Coord(-2, 2)
-                && to != from + Coord(2, -2) && to != from + Coord(-2, -2)) return false;
-            if (to == from + Coord(1, 1) && is_in_board(to.x, to.y)
-                && get_field(to).has_value()) return false;
-            if (to == from + Coord(-1, 1) && is_in_board(to.x, to.y)
-                && get_field(to).has_value()) return false;
-            if (to == from + Coord(2, 2) && is_in_board(to.x, to.y)
-                && (!is_enemy_player_piece(from + Coord(1, 1))
-                    || get_field(to).has_value() )) return false;
-            if (to == from + Coord(-2, 2) && is_in_board(to.x, to.y)
-                && (!is_enemy_player_piece(from + Coord(-1, 1))
-                    || get_field(to).has_value() )) return false;
-            if (to == from + Coord(2, -2) && is_in_board(to.x, to.y)
-                && (!is_enemy_player_piece(from + Coord(1, -1))
-                    || get_field(to).has_value() )) return false;
-            if (to == from + Coord(-2, -2) && is_in_board(to.x, to.y)
-                && (!is_enemy_player_piece(from + Coord(-1, -1))
-                    || get_field(to).has_value() )) return false;
-            break;
-
-        case BLACK_PAWN:
-            if (to != from + Coord(1, -1) && to != from + Coord(-1, -1)
-                && to != from + Coord(2, -2) && to != from + Coord(-2, -2)
-                && to != from + Coord(2, 2) && to != from + Coord(-2, 2)) return false;
-            if (to == from + Coord(1, -1) && is_in_board(to.x, to.y)
-                && get_field(to).has_value()) return false;
-            if (to == from + Coord(-1, -1) && is_in_board(to.x, to.y)
-                && get_field(to).has_value()) return false;
-            if (to == from + Coord(2, -2) && is_in_board(to.x, to.y)
-                && (!is_enemy_player_piece(from + Coord(1, -1))
-                    || get_field(to).has_value() )) return false;
-            if (to == from + Coord(-2, -2) && is_in_board(to.x, to.y)
-                && (!is_enemy_player_piece(from + Coord(-1, -1))
-                    || get_field(to).has_value() )) return false;
-            if (to == from + Coord(2, 2) && is_in_board(to.x, to.y)
-                && (!is_enemy_player_piece(from + Coord(1, 1))
-                    || get_field(to).has_value() )) return false;
-            if (to == from + Coord(-2, 2) && is_in_board(to.x, to.y)
-                && (!is_enemy_player_piece(from + Coord(-1, 1))
-                    || get_field(to).has_value() )) return false;
-            break;
+}
 
-        case WHITE_QUEEN:
-        case BLACK_QUEEN:
-            if (abs(from.x - to.x) != abs(from.y - to.y)) return false;
-            if (is_in_board(to.x, to.y)
-                && (get_field(to).has_value()
-                    || !(is_only_one_enemy_between(from, to)
-                         || is_empty_between(from, to)))) return false;
+template<class Rules>
+template<PlayerEnum Side>
+bool BasicGameState<Rules>::can_move_piece_relaxed(Square from, Square to) const {
+    Mask occupied = white | black;
+    if (!(own_pieces<Side>() & Board::square_mask(from))) return false;
+    if (occupied & Board::square_mask(to)) return false;
+    if (lastMove != NO_SQUARE && lastMove != from) return false;
+
+    auto relation = Board::RELATION[from][to];
+    if (relation.direction == NO_DIRECTION) return false;
+
+    if (!(queens & Board::square_mask(from))) {
+        bool forward = SideTraits<Side>::is_forward(relation.direction);
+        if (relation.distance == 1) return forward;
+        return relation.distance == 2 && (Rules::PAWNS_CAPTURE_BACKWARDS || forward)
+               && (enemy_pieces<Side>() & Board::square_mask(Board::NEIGHBOUR[from][relation.direction]));
     }
-    return true;
+    if (!Rules::FLYING_QUEENS && relation.distance > 2) return false;
+    if (!Rules::FLYING_QUEENS && relation.distance == 2) {
+        return enemy_pieces<Side>() & Board::square_mask(Board::NEIGHBOUR[from][relation.direction]);
+    }
+    return is_only_one_enemy_between<Side>(from, to) || is_empty_between(from, to);
 }
 
-bool GameState::piece_has_attacks(Coord field) const {
-    if (!get_field(field).has_value()) return false;
-
-    switch (get_field(field).value()) {
-        case WHITE_PAWN:
-        case BLACK_PAWN:
-            if (is_in_board(field.x - 2, field.y + 2) && can_move_piece_relaxed(field, field + Coord(-2, 2))) {
-                return true;
-            }
-            if (is_in_board(field.x + 2, field.y + 2) && can_move_piece_relaxed(field, field + Coord(2, 2))) {
-                return true;
-            }
-            if (is_in_board(field.x - 2, field.y - 2) && can_move_piece_relaxed(field, field + Coord(-2, -2))) {
-                return true;
-            }
-            if (is_in_board(field.x + 2, field.y - 2) && can_move_piece_relaxed(field, field + Coord(2, -2))) {
+template<class Rules>
+template<PlayerEnum Side>
+bool BasicGameState<Rules>::piece_has_attacks(Square field) const {
+    Mask occupied = white | black;
+    if (!(occupied & Board::square_mask(field))) return false;
+    Mask enemies = enemy_pieces<Side>();
+
+    if (!(queens & Board::square_mask(field))) {
+        constexpr int pawnJumps = Rules::PAWNS_CAPTURE_BACKWARDS ? 4 : 2;
+        for (int i = 0; i < pawnJumps; ++i) {
+            DirectionEnum dir = SideTraits<Side>::JUMPS[i];
+            Square target = Board::JUMP[field][dir];
+            if (target != NO_SQUARE && !(occupied & Board::square_mask(target))
+                && (enemies & Board::square_mask(Board::NEIGHBOUR[field][dir]))) {
                 return true;
             }
-            break;
+        }
+        return false;
+    }
 
-        case WHITE_QUEEN:
-        case BLACK_QUEEN:
-            for (int dx = 1, dy = 1; dx < 8; ++dx, ++dy) {
-                if (is_in_board(field.x + dx, field.y + dy)
-                    && !get_field(field + Coord(dx, dy)).has_value()
-                    && is_only_one_enemy_between(field, field + Coord(dx, dy))) return true;
-                if (is_in_board(field.x - dx, field.y + dy)
-                    && !get_field(field + Coord(-dx, dy)).has_value()
-                    && is_only_one_enemy_between(field, field + Coord(-dx, dy))) return true;
-                if (is_in_board(field.x + dx, field.y - dy)
-                    && !get_field(field + Coord(dx, -dy)).has_value()
-                    && is_only_one_enemy_between(field, field + Coord(dx, -dy))) return true;
-                if (is_in_board(field.x - dx, field.y - dy)
-                    && !get_field(field + Coord(-dx, -dy)).has_value()
-                    && is_only_one_enemy_between(field, field + Coord(-dx, -dy))) return true;
+    for (int dir = 0; dir < DIRECTIONS; ++dir) {
+        int length = Board::RAY.length[field][dir];
+        if constexpr (!Rules::FLYING_QUEENS) {
+            length = std::min(length, 2);
+        }
+        for (int i = 0; i < length; ++i) {
+            Square square = Board::RAY.squares[field][dir][i];
+            if (!(occupied & Board::square_mask(square))) {
+                if (!Rules::FLYING_QUEENS) break;
+                continue;
             }
+            if ((enemies & Board::square_mask(square)) && i + 1 < length
+                && !(occupied & Board::square_mask(Board::RAY.squares[field][dir][i + 1]))) return true;
+            break;
+        }
     }
     return false;
 }
 
-void GameState::push_past_board_state() {
-    std::string state;
-    for (int x = 0; x < 8; ++x) {
-        for (int y = 0; y < 8; ++y) {
-            if ((x + y) % 2 == 0) {
-                if (get_field(Coord(x, y)).has_value()) {
-                    auto piece = get_field(Coord(x, y));
-                    if (piece == WHITE_PAWN) {
-                        state.push_back('w');
-                    } else if (piece == WHITE_QUEEN) {
-                        state.push_back('W');
-                    } else if (piece == BLACK_PAWN) {
-                        state.push_back('b');
-                    } else {
-                        state.push_back('B');
-                    }
-                } else {
-                    state.push_back(' ');
-                }
-            }
-        }
-    }
-    pastBoardStates.push_back(std::move(state));
+template<class Rules>
+void BasicGameState<Rules>::push_past_board_state() {
+    history[historyCount % HISTORY_SIZE] = get_fingerprint();
+    ++historyCount;
 }
 
-void GameState::update_tie_conditions(bool irreversible) {
+template<class Rules>
+void BasicGameState<Rules>::update_tie_conditions(bool irreversible) {
     if (irreversible) {
-        pastBoardStates.clear();
+        historyCount = 0;
         queenMovesNoTake = 0;
     }
     push_past_board_state();
     queenMovesNoTake += 1;
 }
 
-bool GameState::has_tie_happened() const {
-    if (queenMovesNoTake >= 30) return true;
+template<class Rules>
+bool BasicGameState<Rules>::has_tie_happened() const {
+    if (queenMovesNoTake >= Rules::QUEEN_MOVES_TIE) return true;
+    if (historyCount == 0) return false;
 
     int repeats = 0;
-    const std::string &last = pastBoardStates.back();
-    for (auto state : pastBoardStates) {
-        if (state == last) {
+    int stored = std::min<int>(historyCount, HISTORY_SIZE);
+    std::uint32_t last = history[(historyCount - 1) % HISTORY_SIZE];
+    for (int i = 0; i < stored; ++i) {
+        if (history[i] == last) {
             ++repeats;
         }
     }
@@ -366,93 +668,113 @@ bool GameState::has_tie_happened() const {
     return false;
 }
 
-bool GameState::is_empty_between(Coord start, Coord end) const {
-    int dx, dy;
-    if (start.x < end.x) {
-        dx = 1;
-    } else {
-        dx = -1;
-    }
-    if (start.y < end.y) {
-        dy = 1;
-    } else {
-        dy = -1;
-    }
-    for (int i = 1; i < abs(end.x - start.x); ++i) {
-        if (get_field(start + Coord(dx * i, dy * i)).has_value()) {
+template<class Rules>
+bool BasicGameState<Rules>::is_empty_between(Square start, Square end) const {
+    auto relation = Board::RELATION[start][end];
+    for (int i = 0; i + 1 < relation.distance; ++i) {
+        if ((white | black) & Board::square_mask(Board::RAY.squares[start][relation.direction][i])) {
             return false;
         }
     }
     return true;
 }
 
-bool GameState::is_only_one_enemy_between(Coord start, Coord end) const {
-    int dx, dy;
-    if (start.x < end.x) {
-        dx = 1;
-    } else {
-        dx = -1;
-    }
-    if (start.y < end.y) {
-        dy = 1;
-    } else {
-        dy = -1;
-    }
+template<class Rules>
+template<PlayerEnum Side>
+bool BasicGameState<Rules>::is_only_one_enemy_between(Square start, Square end) const {
+    auto relation = Board::RELATION[start][end];
+    Mask enemies = enemy_pieces<Side>();
     int count = 0;
-    for (int i = 1; i < abs(end.x - start.x); ++i) {
-        if (get_field(start + Coord(dx * i, dy * i)).has_value()) {
-
-        }
-        if (is_enemy_player_piece(start + Coord(dx * i, dy * i))) {
+    for (int i = 0; i + 1 < relation.distance; ++i) {
+        Square square = Board::RAY.squares[start][relation.direction][i];
+        if (enemies & Board::square_mask(square)) {
             ++count;
-        } else if (is_current_player_piece(start + Coord(dx * i, dy * i))) {
+        } else if ((white | black) & Board::square_mask(square)) {
             return false;
         }
     }
     return count == 1;
 }
 
-void GameState::update_game_progress() {
+template<class Rules>
+void BasicGameState<Rules>::update_game_progress() {
     if (has_tie_happened()) {
         gameProgress = TIE;
-    } else if (currentPlayer == BLACK && pieces_with_moves().size() == 0) {
+    } else if (currentPlayer == BLACK && legal_moves().empty()) {
         gameProgress = WHITE_WON;
-    } else if (currentPlayer == WHITE && pieces_with_moves().size() == 0) {
+    } else if (currentPlayer == WHITE && legal_moves().empty()) {
         gameProgress = BLACK_WON;
     }
 }
 
-bool GameState::is_current_player_piece(Coord field) const {
-    if (!get_field(field).has_value()) return false;
-    if (currentPlayer == WHITE
-        && !(get_field(field).value() == WHITE_PAWN || get_field(field).value() == WHITE_QUEEN)) return false;
-    if (currentPlayer == BLACK
-        && !(get_field(field).value() == BLACK_PAWN || get_field(field).value() == BLACK_QUEEN)) return false;
-    return true;
+template<class Rules>
+bool BasicGameState<Rules>::is_current_player_piece(Square field) const {
+    return (currentPlayer == WHITE ? white : black) & Board::square_mask(field);
 }
 
-bool GameState::is_enemy_player_piece(Coord field) const {
-    if (!get_field(field).has_value()) return false;
-    if (currentPlayer == WHITE
-        && (get_field(field).value() == WHITE_PAWN || get_field(field).value() == WHITE_QUEEN)) return false;
-    if (currentPlayer == BLACK
-        && (get_field(field).value() == BLACK_PAWN || get_field(field).value() == BLACK_QUEEN)) return false;
-    return true;
+template<class Rules>
+template<PlayerEnum Side>
+auto BasicGameState<Rules>::own_pieces() const -> Mask {
+    return Side == WHITE ? white : black;
 }
 
-void GameState::clear_between(Coord start, Coord end) {
-    int dx, dy;
-    if (start.x < end.x) {
-        dx = 1;
-    } else {
-        dx = -1;
+template<class Rules>
+template<PlayerEnum Side>
+auto BasicGameState<Rules>::enemy_pieces() const -> Mask {
+    // Bierki zbite w trwającym łańcuchu nie mogą zostać zbite ponownie.
+    return (Side == WHITE ? black : white) & ~captured;
+}
+
+template<class Rules>
+void BasicGameState<Rules>::clear_between(Square start, Square end) {
+    auto relation = Board::RELATION[start][end];
+    for (int i = 0; i + 1 < relation.distance; ++i) {
+        Square square = Board::RAY.squares[start][relation.direction][i];
+        if constexpr (Rules::REMOVE_CAPTURED_AT_END) {
+            captured |= (white | black) & Board::square_mask(square);
+        } else {
+            set_field(square, std::nullopt);
+        }
     }
-    if (start.y < end.y) {
-        dy = 1;
-    } else {
-        dy = -1;
+}
+
+LegalMoveSet::LegalMoveSet(const GameState &gameState)
+    : capture(gameState.must_capture())
+{
+    for (auto move : gameState.legal_moves()) {
+        pieces |= square_mask(move.from);
+        targets[move.from] |= square_mask(move.to);
     }
-    for (int i = 1; i < abs(end.x - start.x); ++i) {
-        set_field(start + Coord(dx * i, dy * i), std::nullopt);
+}
+
+bool LegalMoveSet::can_select_field(Coord field) const {
+    return is_playable(field) && (pieces & square_mask(to_square(field)));
+}
+
+bool LegalMoveSet::can_move_piece(Coord from, Coord to) const {
+    return is_playable(to) && (get_targets(from) & square_mask(to_square(to)));
+}
+
+std::vector<Coord> LegalMoveSet::piece_moves(Coord field) const {
+    std::vector<Coord> moves;
+    std::uint32_t mask = get_targets(field);
+    for (Square square = 0; square < SQUARES; ++square) {
+        if (mask & square_mask(square)) moves.push_back(to_coord(square));
     }
-}
\ No newline at end of file
+    return moves;
+}
+
+std::uint32_t LegalMoveSet::get_targets(Coord field) const {
+    return is_playable(field) ? targets[to_square(field)] : 0;
+}
+
+bool LegalMoveSet::is_capture() const {
+    return capture;
+}
+
+namespace checkers
+{
+    template class BasicGameState<RussianRules>;
+    template class BasicGameState<EnglishRules>;
+    template class BasicGameState<InternationalRules>;
+} // namespace checkers
@@ -0,0 +1,310 @@
+/**
+ * @file Mcts.cpp
+ * @author Bartosz Świrta
+ * @brief Zawiera definicję metod klas NodePool i Mcts.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "../include/Mcts.hpp"
+#include "../include/BotMove.hpp"
+#include "../include/EvalCache.hpp"
+#include "../include/Trace.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+using namespace checkers;
+using namespace checkers::bot;
+
+namespace
+{
+    /// Ocena heurystyką przez tablicę ocen współdzieloną przez wątki i kolejne przeszukiwania.
+    int cached_estimate(const GameState &gameState, HeuristicEnum heuristicType)
+    {
+        if (gameState.get_game_progress() != PLAYING) return estimate_move(gameState, heuristicType);
+        EvalCache &cache = shared_eval_cache();
+        std::uint64_t hash = gameState.get_hash();
+        if (auto cached = cache.probe(hash, heuristicType)) return cached.value();
+        int eval = estimate_move(gameState, heuristicType);
+        cache.store(hash, heuristicType, eval);
+        return eval;
+    }
+} // namespace
+
+NodePool::NodePool(std::size_t capacity_, std::pmr::memory_resource *memory_)
+    : capacity(capacity_), memory(memory_),
+      nodes(static_cast<MctsNode *>(memory_->allocate(capacity_ * sizeof(MctsNode), alignof(MctsNode))))
+{
+    std::uninitialized_default_construct_n(nodes, capacity);
+}
+
+NodePool::~NodePool()
+{
+    std::destroy_n(nodes, capacity);
+    memory->deallocate(nodes, capacity * sizeof(MctsNode), alignof(MctsNode));
+}
+
+NodeIndex NodePool::allocate(std::size_t count)
+{
+    std::size_t first = used.fetch_add(count, std::memory_order_relaxed);
+    if (first + count > capacity) return NO_NODE;
+    return static_cast<NodeIndex>(first);
+}
+
+std::size_t NodePool::size() const
+{
+    return std::min(used.load(std::memory_order_relaxed), capacity);
+}
+
+Mcts::Mcts(HeuristicEnum heuristicType_, SearchEnum mode_, const MctsOptions &options_,
+           std::pmr::memory_resource *memory_)
+    : heuristicType(heuristicType_), mode(mode_), options(options_), memory(memory_)
+{
+}
+
+void Mcts::set_progress_callback(std::function<void(const SearchInfo &)> callback)
+{
+    onProgress = std::move(callback);
+}
+
+std::optional<MctsResult> Mcts::run(const GameState &gameState)
+{
+    if (gameState.get_game_progress() != PLAYING || gameState.legal_moves().empty()) {
+        return std::nullopt;
+    }
+    auto startTime = std::chrono::steady_clock::now();
+    started = 0;
+    finishedWorkers = 0;
+    deadline = std::nullopt;
+    if (options.time.has_value()) {
+        deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(options.time.value());
+    }
+
+    int threadCount = std::max(1, options.threads);
+    std::size_t iterations = static_cast<std::size_t>(std::max(1, options.iterations));
+    bool shared = mode == MCTS_TREE;
+    int treeCount = shared ? 1 : threadCount;
+    std::size_t capacity = std::min(MCTS_MAX_NODES,
+                                    iterations / treeCount * MCTS_NODES_PER_ITERATION + MoveList::MAX_MOVES + 1);
+
+    // Korzenie rozwijane są przed startem wątków, więc każde drzewo ma ruchy do wyboru nawet bez symulacji.
+    // Obszar jest używany tylko w tym wątku, wątki przeszukujące jedynie czytają i zapisują węzły.
+    std::pmr::monotonic_buffer_resource arena(memory);
+    std::pmr::polymorphic_allocator<NodePool> poolAllocator(&arena);
+    std::pmr::vector<NodePool *> pools(&arena);
+    for (int i = 0; i < treeCount; ++i) {
+        NodePool *pool = poolAllocator.allocate(1);
+        poolAllocator.construct(pool, capacity, &arena);
+        pools.push_back(pool);
+        NodeIndex root = pools.back()->allocate(1);
+        (*pools.back())[root].mover = gameState.get_current_player() == WHITE ? BLACK : WHITE;
+        expand(*pools.back(), root, gameState);
+    }
+
+    std::pmr::vector<std::thread> workers(&arena);
+    for (int i = 0; i < threadCount; ++i) {
+        NodePool &pool = *pools[shared ? 0 : i];
+        workers.emplace_back([this, &pool, &gameState, i, shared, threadCount]() {
+            trace::set_thread_name("mcts");
+            std::mt19937 rng(static_cast<std::mt19937::result_type>(i + 1));
+            search_tree(pool, gameState, rng, shared && threadCount > 1);
+            {
+                std::lock_guard<std::mutex> lock(workersMutex);
+                ++finishedWorkers;
+            }
+            workersDone.notify_one();
+        });
+    }
+    auto report = [&]() {
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+        onProgress(SearchInfo{0, std::min<std::uint64_t>(started.load(), iterations), elapsed, {}, {}});
+    };
+    if (onProgress) {
+        std::unique_lock<std::mutex> lock(workersMutex);
+        while (!workersDone.wait_for(lock, PROGRESS_INTERVAL, [&]() { return finishedWorkers == threadCount; })) {
+            lock.unlock();
+            report();
+            lock.lock();
+        }
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    // Dzieci korzenia są w każdym drzewie w tej samej kolejności (kolejność generowania ruchów).
+    const MctsNode &firstRoot = (*pools[0])[0];
+    int best = 0;
+    std::pmr::vector<int> visits(firstRoot.childCount, 0, &arena);
+    std::pmr::vector<int> values(firstRoot.childCount, 0, &arena);
+    std::uint64_t nodes = 0;
+    for (auto &pool : pools) {
+        const MctsNode &root = (*pool)[0];
+        for (int i = 0; i < root.childCount; ++i) {
+            visits[i] += (*pool)[root.firstChild + i].visits.load();
+            values[i] += (*pool)[root.firstChild + i].value.load();
+        }
+        nodes += pool->size();
+    }
+    for (int i = 1; i < firstRoot.childCount; ++i) {
+        if (visits[i] > visits[best]) best = i;
+    }
+
+    MctsResult result;
+    result.move = (*pools[0])[firstRoot.firstChild + best].move;
+    result.visits = visits[best];
+    result.score = visits[best] > 0 ? values[best] / (2.0 * visits[best]) : 0.5;
+    result.iterations = std::min<std::uint64_t>(started.load(), iterations);
+    result.nodes = nodes;
+    for (NodePool *pool : pools) {
+        pool->~NodePool();
+    }
+    if (onProgress) report();
+    return result;
+}
+
+void Mcts::search_tree(NodePool &pool, const GameState &root, std::mt19937 &rng, bool virtualLoss)
+{
+    std::byte buffer[MCTS_PATH_BYTES];
+    std::pmr::monotonic_buffer_resource pathMemory(buffer, sizeof(buffer));
+    std::pmr::vector<NodeIndex> path(&pathMemory);
+    path.reserve(MCTS_PATH_BYTES / sizeof(NodeIndex) / 2);
+    while (started.fetch_add(1, std::memory_order_relaxed) < static_cast<std::uint64_t>(options.iterations)) {
+        if (deadline.has_value() && std::chrono::steady_clock::now() >= deadline.value()) break;
+        iterate(pool, root, rng, virtualLoss, path);
+    }
+}
+
+void Mcts::iterate(NodePool &pool, const GameState &root, std::mt19937 &rng, bool virtualLoss,
+                   std::pmr::vector<NodeIndex> &path)
+{
+    GameState gameState = root;
+    NodeIndex index = 0;
+    bool expanded = false;
+    path.clear();
+    while (true) {
+        path.push_back(index);
+        if (virtualLoss) pool[index].virtualLoss.fetch_add(1, std::memory_order_relaxed);
+        if (expanded || gameState.get_game_progress() != PLAYING) break;
+
+        // Liść jest rozwijany, a symulacja startuje z jednego z jego dzieci.
+        if (pool[index].expansion.load(std::memory_order_acquire) != MctsNode::EXPANDED) {
+            if (!expand(pool, index, gameState)) break;
+            expanded = true;
+        }
+        index = select(pool, index);
+        gameState.try_make_move(pool[index].move);
+    }
+
+    GameProgressEnum result = gameState.get_game_progress();
+    if (result == PLAYING) {
+        result = playout(gameState, rng);
+    }
+
+    for (NodeIndex node : path) {
+        int reward = 1;
+        if (result != TIE) {
+            reward = (result == WHITE_WON) == (pool[node].mover == WHITE) ? 2 : 0;
+        }
+        pool[node].value.fetch_add(reward, std::memory_order_relaxed);
+        pool[node].visits.fetch_add(1, std::memory_order_relaxed);
+        if (virtualLoss) pool[node].virtualLoss.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+bool Mcts::expand(NodePool &pool, NodeIndex index, const GameState &gameState)
+{
+    MctsNode &node = pool[index];
+    std::uint8_t expected = MctsNode::LEAF;
+    if (!node.expansion.compare_exchange_strong(expected, MctsNode::EXPANDING, std::memory_order_acq_rel)) {
+        return false;
+    }
+
+    MoveList moves = gameState.legal_moves();
+    NodeIndex first = pool.allocate(moves.size());
+    if (first == NO_NODE) {
+        node.expansion.store(MctsNode::LEAF, std::memory_order_release);
+        return false;
+    }
+
+    for (int i = 0; i < moves.size(); ++i) {
+        MctsNode &child = pool[first + i];
+        child.move = moves[i];
+        child.mover = gameState.get_current_player();
+        if (options.playout == HEURISTIC_PLAYOUT) {
+            // Ocena pozycji po ruchu zasila węzeł kilkoma wirtualnymi odwiedzinami.
+            GameState childState = gameState;
+            childState.try_make_move(moves[i]);
+            int eval = cached_estimate(childState, heuristicType);
+            if (child.mover == BLACK) eval = -eval;
+            double probability = 1.0 / (1.0 + std::exp(-eval / MCTS_PRIOR_SCALE));
+            child.visits.store(MCTS_PRIOR_VISITS, std::memory_order_relaxed);
+            child.value.store(static_cast<int>(std::lround(2.0 * probability * MCTS_PRIOR_VISITS)),
+                              std::memory_order_relaxed);
+        }
+    }
+    node.firstChild = first;
+    node.childCount = static_cast<std::uint16_t>(moves.size());
+    node.expansion.store(MctsNode::EXPANDED, std::memory_order_release);
+    return true;
+}
+
+NodeIndex Mcts::select(const NodePool &pool, NodeIndex index) const
+{
+    const MctsNode &node = pool[index];
+    int parentVisits = node.visits.load(std::memory_order_relaxed) + node.virtualLoss.load(std::memory_order_relaxed);
+    double logParent = std::log(parentVisits + 1.0);
+
+    NodeIndex best = node.firstChild;
+    double bestScore = -1.0;
+    for (NodeIndex child = node.firstChild; child < node.firstChild + node.childCount; ++child) {
+        // Wirtualne porażki zwiększają liczbę odwiedzin bez wyniku, obniżając ocenę ścieżek w toku.
+        int visits = pool[child].visits.load(std::memory_order_relaxed)
+                     + pool[child].virtualLoss.load(std::memory_order_relaxed);
+        if (visits == 0) return child;
+        double score = pool[child].value.load(std::memory_order_relaxed) / (2.0 * visits)
+                       + MCTS_EXPLORATION * std::sqrt(logParent / visits);
+        if (score > bestScore) {
+            bestScore = score;
+            best = child;
+        }
+    }
+    return best;
+}
+
+GameProgressEnum Mcts::playout(GameState gameState, std::mt19937 &rng) const
+{
+    int limit = options.playout == HEURISTIC_PLAYOUT ? MCTS_PLAYOUT_CUTOFF : MCTS_MAX_PLAYOUT_PLIES;
+    for (int ply = 0; ply < limit && gameState.get_game_progress() == PLAYING; ++ply) {
+        MoveList moves = gameState.legal_moves();
+        std::uniform_int_distribution<int> pick(0, moves.size() - 1);
+        gameState.try_make_move(moves[pick(rng)]);
+    }
+    if (gameState.get_game_progress() != PLAYING || options.playout == RANDOM_PLAYOUT) {
+        return gameState.get_game_progress() == PLAYING ? TIE : gameState.get_game_progress();
+    }
+
+    int eval = cached_estimate(gameState, heuristicType);
+    if (eval >= MCTS_PLAYOUT_MARGIN) return WHITE_WON;
+    if (eval <= -MCTS_PLAYOUT_MARGIN) return BLACK_WON;
+    return TIE;
+}
+
+std::pair<Coord, Coord> checkers::bot::mcts_move(const GameState &gameState, HeuristicEnum heuristicType,
+                                                 SearchEnum mode, const MctsOptions &options,
+                                                 const std::function<void(const SearchInfo &)> &progress,
+                                                 std::pmr::memory_resource *memory)
+{
+    trace::Span span("mcts_move", options.iterations);
+    Mcts mcts(heuristicType, mode, options, memory);
+    mcts.set_progress_callback(progress);
+    auto result = mcts.run(gameState);
+    if (!result.has_value()) {
+        return std::make_pair(Coord(0,0), Coord(0,0));
+    }
+    return std::make_pair(to_coord(result.value().move.from), to_coord(result.value().move.to));
+}
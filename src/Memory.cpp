@@ -0,0 +1,172 @@
+/**
+ * @file Memory.cpp
+ * @author Maciej Wojno
+ * @brief Zawiera definicję liczenia alokacji (zastąpienie globalnego operatora new)
+ *        i odczytu zajętej pamięci procesu.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "../include/Memory.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string>
+
+using namespace checkers;
+
+namespace
+{
+    std::atomic<bool> countingEnabled{false};
+    /// Liczniki obecnego wątku. Mają stałą inicjalizację, więc operator new może z nich korzystać od startu wątku.
+    thread_local memory::AllocationCounters threadCounters;
+
+    void count(std::size_t size)
+    {
+        if (countingEnabled.load(std::memory_order_relaxed)) {
+            ++threadCounters.allocations;
+            threadCounters.bytes += size;
+        }
+    }
+
+    void *allocate(std::size_t size)
+    {
+        count(size);
+        void *pointer = std::malloc(size == 0 ? 1 : size);
+        if (pointer == nullptr) throw std::bad_alloc();
+        return pointer;
+    }
+
+    void *allocate_aligned(std::size_t size, std::align_val_t alignment)
+    {
+        count(size);
+        std::size_t align = static_cast<std::size_t>(alignment);
+        // aligned_alloc wymaga rozmiaru będącego wielokrotnością wyrównania.
+        std::size_t rounded = (std::max<std::size_t>(size, 1) + align - 1) / align * align;
+        void *pointer = std::aligned_alloc(align, rounded);
+        if (pointer == nullptr) throw std::bad_alloc();
+        return pointer;
+    }
+
+    /// Odczytuje wartość w KiB z linii "Nazwa: wartość kB" pliku /proc/self/status.
+    std::optional<std::uint64_t> status_value(const std::string &line, const std::string &key)
+    {
+        if (line.rfind(key, 0) != 0) return std::nullopt;
+        std::istringstream value(line.substr(key.size()));
+        std::uint64_t kb = 0;
+        if (!(value >> kb)) return std::nullopt;
+        return kb;
+    }
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void *operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocate_aligned(size, alignment);
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return allocate_aligned(size, alignment);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept
+{
+    std::free(pointer);
+}
+
+void memory::set_counting(bool enabled)
+{
+    countingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool memory::counting()
+{
+    return countingEnabled.load(std::memory_order_relaxed);
+}
+
+memory::AllocationCounters memory::thread_counters()
+{
+    return threadCounters;
+}
+
+std::optional<memory::ResidentMemory> memory::read_resident_memory()
+{
+    std::ifstream status("/proc/self/status");
+    if (!status) return std::nullopt;
+    ResidentMemory result;
+    bool found = false;
+    std::string line;
+    while (std::getline(status, line)) {
+        if (auto kb = status_value(line, "VmRSS:")) {
+            result.residentKb = kb.value();
+            found = true;
+        } else if (auto peak = status_value(line, "VmHWM:")) {
+            result.peakResidentKb = peak.value();
+        }
+    }
+    if (!found) return std::nullopt;
+    return result;
+}
+
+memory::AllocationScope::AllocationScope()
+    : begin(thread_counters())
+{
+}
+
+memory::AllocationCounters memory::AllocationScope::elapsed() const
+{
+    AllocationCounters now = thread_counters();
+    return AllocationCounters{now.allocations - begin.allocations, now.bytes - begin.bytes};
+}
@@ -10,6 +10,7 @@
  */
 
 #include "../include/MessageQueues.hpp"
+#include "../include/Trace.hpp"
 
 using namespace checkers;
 
@@ -37,6 +38,7 @@ void MessageQueues::send_player_input(const PlayerInputMessage input)
  */
 PlayerInputMessage MessageQueues::wait_for_player_input()
 {
+    trace::Span span("wait_for_player_input");
     std::unique_lock<std::mutex> lk(playerInputQueueMutex);
     std::queue<PlayerInputMessage> *queue = &this->playerInputQueue;
     playerInputWaitCondition.wait(lk, [queue] { return !queue->empty(); });
@@ -46,6 +48,22 @@ PlayerInputMessage MessageQueues::wait_for_player_input()
     return pi;
 }
 
+/**
+ * @brief Odebranie wiadomości o akcji gracza z kolejki bez czekania.
+ *
+ * @return std::optional<PlayerInputMessage> - wiadomość z akcją gracza lub nullopt jeśli kolejka jest pusta
+ */
+std::optional<PlayerInputMessage> MessageQueues::check_for_player_input()
+{
+    std::lock_guard<std::mutex> lg(playerInputQueueMutex);
+    if (playerInputQueue.empty()) {
+        return std::nullopt;
+    }
+    const PlayerInputMessage pi = playerInputQueue.front();
+    playerInputQueue.pop();
+    return pi;
+}
+
 /**
  * @brief Wysłanie nowego stanu gry do kolejki.
  * 
@@ -74,3 +92,24 @@ std::optional<const GameStateMessage> MessageQueues::check_for_game_state()
         return gs;
     }
 }
+
+/**
+ * @brief Opublikowanie statystyk bota.
+ * @details Nie blokuje, więc może być wywoływane w trakcie przeszukiwania.
+ *
+ * @param stats_ - migawka statystyk.
+ */
+void MessageQueues::publish_stats(const StatsMessage &stats_)
+{
+    stats.publish(stats_);
+}
+
+/**
+ * @brief Odebranie najnowszych statystyk bota.
+ *
+ * @return std::optional<StatsMessage> - statystyki lub nullopt jeśli nie zmieniły się od ostatniego odczytu.
+ */
+std::optional<StatsMessage> MessageQueues::check_for_stats()
+{
+    return stats.check();
+}
@@ -0,0 +1,288 @@
+/**
+ * @file Nnue.cpp
+ * @author Bartosz Świrta
+ * @brief Zawiera definicję metod klasy Network.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "../include/Nnue.hpp"
+#include "../include/BotMove.hpp"
+#include "../include/EvalCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NNUE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+using namespace checkers;
+using namespace checkers::bot;
+
+namespace
+{
+    constexpr char NNUE_MAGIC[4] = {'C', 'K', 'N', 'N'};
+    constexpr std::uint32_t NNUE_VERSION = 1;
+
+    std::unique_ptr<Network> loadedNetwork;
+
+    int feature_index(PieceEnum piece, Square square)
+    {
+        return static_cast<int>(piece) * SQUARES + square;
+    }
+
+    template <typename T>
+    bool read(std::ifstream &file, T &value)
+    {
+        return static_cast<bool>(file.read(reinterpret_cast<char *>(&value), sizeof(value)));
+    }
+
+    template <typename T>
+    void write(std::ofstream &file, const T &value)
+    {
+        file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+} // namespace
+
+static_assert(NNUE_ACTIVATION_MAX == 127, "SSE2 packing saturates activations at the int8 maximum");
+static_assert(NNUE_HIDDEN % 16 == 0, "hidden layer is processed in 16-lane blocks");
+
+std::optional<Network> Network::try_load(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return std::nullopt;
+
+    char magic[4];
+    std::uint32_t version, inputs, hidden, hidden2;
+    if (!read(file, magic) || std::memcmp(magic, NNUE_MAGIC, sizeof(magic)) != 0) return std::nullopt;
+    if (!read(file, version) || version != NNUE_VERSION) return std::nullopt;
+    if (!read(file, inputs) || !read(file, hidden) || !read(file, hidden2)) return std::nullopt;
+    if (inputs != NNUE_INPUTS || hidden != NNUE_HIDDEN || hidden2 != NNUE_HIDDEN2) return std::nullopt;
+
+    Network network;
+    if (!read(file, network.featureWeights) || !read(file, network.featureBias)
+        || !read(file, network.hiddenWeights) || !read(file, network.hiddenBias)
+        || !read(file, network.outputWeights) || !read(file, network.outputBias)) return std::nullopt;
+    if (file.peek() != std::ifstream::traits_type::eof()) return std::nullopt;
+    network.positionalMargin = network.compute_positional_margin();
+    return network;
+}
+
+Network Network::bootstrap()
+{
+    Network network;
+    std::memset(&network, 0, sizeof(network));
+
+    // Neuron sq odpowiada białej bierce na polu sq, neuron SQUARES + sq czarnej.
+    // Wartość bierki razy 8, tak żeby para neuronów po przesunięciu w drugiej warstwie dała 4 * wartość.
+    for (Square square = 0; square < SQUARES; ++square) {
+        int x = squares::square_x(square);
+        int y = squares::square_y(square);
+        bool safe = x == 0 || x == 7;
+        int whiteBonus = safe ? boardAwareHeuristicTable[4] : (y > 4 ? boardAwareHeuristicTable[6] : 0);
+        int blackBonus = safe ? boardAwareHeuristicTable[5] : (y < 3 ? boardAwareHeuristicTable[7] : 0);
+
+        network.featureWeights[feature_index(WHITE_PAWN, square)][square] =
+                static_cast<std::int16_t>(8 * (boardAwareHeuristicTable[0] + whiteBonus));
+        network.featureWeights[feature_index(WHITE_QUEEN, square)][square] =
+                static_cast<std::int16_t>(8 * (boardAwareHeuristicTable[1] + whiteBonus));
+        network.featureWeights[feature_index(BLACK_PAWN, square)][SQUARES + square] =
+                static_cast<std::int16_t>(8 * (boardAwareHeuristicTable[2] + blackBonus));
+        network.featureWeights[feature_index(BLACK_QUEEN, square)][SQUARES + square] =
+                static_cast<std::int16_t>(8 * (boardAwareHeuristicTable[3] + blackBonus));
+    }
+    // Neuron j drugiej warstwy to połowa sumy neuronów 2j i 2j + 1, wyjście to białe minus czarne.
+    for (int j = 0; j < NNUE_HIDDEN2; ++j) {
+        network.hiddenWeights[j][2 * j] = 1 << (NNUE_HIDDEN2_SHIFT - 1);
+        network.hiddenWeights[j][2 * j + 1] = 1 << (NNUE_HIDDEN2_SHIFT - 1);
+        network.outputWeights[j] = 2 * j < SQUARES ? 1 : -1;
+    }
+    // Sieć odtwarza board_aware, więc cichy ruch zmienia ocenę tak samo jak w tej heurystyce.
+    network.positionalMargin = boardAwarePositionalMax;
+    return network;
+}
+
+bool Network::save(const std::string &path) const
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+    std::uint32_t dims[] = {NNUE_VERSION, NNUE_INPUTS, NNUE_HIDDEN, NNUE_HIDDEN2};
+    write(file, NNUE_MAGIC);
+    write(file, dims);
+    write(file, featureWeights);
+    write(file, featureBias);
+    write(file, hiddenWeights);
+    write(file, hiddenBias);
+    write(file, outputWeights);
+    write(file, outputBias);
+    return static_cast<bool>(file);
+}
+
+void Network::apply_feature(Accumulator &accumulator, int feature, int sign) const
+{
+    const std::int16_t *weights = featureWeights[feature];
+#ifdef NNUE_SSE2
+    for (int i = 0; i < NNUE_HIDDEN; i += 8) {
+        __m128i *values = reinterpret_cast<__m128i *>(accumulator.values + i);
+        __m128i row = _mm_load_si128(reinterpret_cast<const __m128i *>(weights + i));
+        *values = sign > 0 ? _mm_add_epi16(*values, row) : _mm_sub_epi16(*values, row);
+    }
+#else
+    for (int i = 0; i < NNUE_HIDDEN; ++i) {
+        accumulator.values[i] = static_cast<std::int16_t>(accumulator.values[i] + sign * weights[i]);
+    }
+#endif
+}
+
+void Network::refresh(const GameState &gameState, Accumulator &accumulator) const
+{
+    std::memcpy(accumulator.values, featureBias, sizeof(featureBias));
+    for (Square square = 0; square < SQUARES; ++square) {
+        auto piece = gameState.get_square(square);
+        if (piece.has_value()) {
+            apply_feature(accumulator, feature_index(piece.value(), square), 1);
+        }
+    }
+}
+
+void Network::update(const Accumulator &parent, Accumulator &child, const GameState &before, const GameState &after) const
+{
+    child = parent;
+    for (Square square = 0; square < SQUARES; ++square) {
+        auto previous = before.get_square(square);
+        auto current = after.get_square(square);
+        if (previous == current) continue;
+        if (previous.has_value()) apply_feature(child, feature_index(previous.value(), square), -1);
+        if (current.has_value()) apply_feature(child, feature_index(current.value(), square), 1);
+    }
+}
+
+int Network::evaluate(const Accumulator &accumulator) const
+{
+    alignas(16) std::int8_t hidden[NNUE_HIDDEN];
+    std::int32_t hidden2[NNUE_HIDDEN2];
+
+#ifdef NNUE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    for (int i = 0; i < NNUE_HIDDEN; i += 16) {
+        __m128i low = _mm_max_epi16(_mm_load_si128(reinterpret_cast<const __m128i *>(accumulator.values + i)), zero);
+        __m128i high = _mm_max_epi16(_mm_load_si128(reinterpret_cast<const __m128i *>(accumulator.values + i + 8)), zero);
+        _mm_store_si128(reinterpret_cast<__m128i *>(hidden + i), _mm_packs_epi16(low, high));
+    }
+    for (int j = 0; j < NNUE_HIDDEN2; ++j) {
+        __m128i sum = zero;
+        for (int i = 0; i < NNUE_HIDDEN; i += 16) {
+            // Aktywacje są nieujemne (rozszerzenie zerami), wagi int8 rozszerzane ze znakiem.
+            __m128i inputs = _mm_load_si128(reinterpret_cast<const __m128i *>(hidden + i));
+            __m128i weights = _mm_load_si128(reinterpret_cast<const __m128i *>(hiddenWeights[j] + i));
+            __m128i signs = _mm_cmpgt_epi8(zero, weights);
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_unpacklo_epi8(inputs, zero), _mm_unpacklo_epi8(weights, signs)));
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_unpackhi_epi8(inputs, zero), _mm_unpackhi_epi8(weights, signs)));
+        }
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+        hidden2[j] = _mm_cvtsi128_si32(sum);
+    }
+#else
+    for (int i = 0; i < NNUE_HIDDEN; ++i) {
+        hidden[i] = static_cast<std::int8_t>(std::clamp<int>(accumulator.values[i], 0, NNUE_ACTIVATION_MAX));
+    }
+    for (int j = 0; j < NNUE_HIDDEN2; ++j) {
+        hidden2[j] = 0;
+        for (int i = 0; i < NNUE_HIDDEN; ++i) {
+            hidden2[j] += hidden[i] * hiddenWeights[j][i];
+        }
+    }
+#endif
+
+    std::int32_t output = outputBias;
+    for (int j = 0; j < NNUE_HIDDEN2; ++j) {
+        int activation = std::clamp((hidden2[j] + hiddenBias[j]) >> NNUE_HIDDEN2_SHIFT, 0, NNUE_ACTIVATION_MAX);
+        output += activation * outputWeights[j];
+    }
+    return output / NNUE_OUTPUT_SCALE;
+}
+
+int Network::evaluate(const GameState &gameState) const
+{
+    Accumulator accumulator;
+    refresh(gameState, accumulator);
+    return evaluate(accumulator);
+}
+
+int Network::positional_margin() const
+{
+    return positionalMargin;
+}
+
+int Network::compute_positional_margin() const
+{
+    int margin = 0;
+    // Przedziały zmian kolejnych warstw: clipped ReLU zachowuje znak zmiany i jej nie powiększa.
+    auto include_move = [&](PieceEnum piece, Square from, Square to) {
+        const std::int16_t *removed = featureWeights[feature_index(piece, from)];
+        const std::int16_t *added = featureWeights[feature_index(piece, to)];
+        int hidden[NNUE_HIDDEN];
+        for (int i = 0; i < NNUE_HIDDEN; ++i) {
+            hidden[i] = std::clamp(added[i] - removed[i], -NNUE_ACTIVATION_MAX, NNUE_ACTIVATION_MAX);
+        }
+        std::int64_t low = 0, high = 0;
+        for (int j = 0; j < NNUE_HIDDEN2; ++j) {
+            std::int64_t sumLow = 0, sumHigh = 0;
+            for (int i = 0; i < NNUE_HIDDEN; ++i) {
+                int product = hiddenWeights[j][i] * hidden[i];
+                (product < 0 ? sumLow : sumHigh) += product;
+            }
+            // Po przesunięciu bitowym (zaokrągleniu w dół) różnica mieści się w zaokrągleniach przedziału na zewnątrz.
+            std::int64_t changeLow = std::max<std::int64_t>(sumLow >> NNUE_HIDDEN2_SHIFT, -NNUE_ACTIVATION_MAX);
+            std::int64_t changeHigh = std::min<std::int64_t>(
+                    (sumHigh + (1 << NNUE_HIDDEN2_SHIFT) - 1) >> NNUE_HIDDEN2_SHIFT, NNUE_ACTIVATION_MAX);
+            int weight = outputWeights[j];
+            low += weight < 0 ? weight * changeHigh : weight * changeLow;
+            high += weight < 0 ? weight * changeLow : weight * changeHigh;
+        }
+        // Zysk liczony jest z perspektywy właściciela bierki (białe maksymalizują ocenę).
+        bool white = piece == WHITE_PAWN || piece == WHITE_QUEEN;
+        std::int64_t gain = std::max<std::int64_t>(white ? high : -low, 0);
+        margin = std::max(margin, static_cast<int>((gain + NNUE_OUTPUT_SCALE - 1) / NNUE_OUTPUT_SCALE));
+    };
+
+    for (Square square = 0; square < SQUARES; ++square) {
+        for (int direction = 0; direction < DIRECTIONS; ++direction) {
+            // Pion bez przemiany: o jedno pole do przodu, poza ostatni rząd.
+            Square target = NEIGHBOUR[square][direction];
+            if (target != NO_SQUARE) {
+                int y = squares::square_y(target);
+                if (squares::DIRECTION_DY[direction] > 0 && y != Board8::BOARD_SIZE - 1) {
+                    include_move(WHITE_PAWN, square, target);
+                } else if (squares::DIRECTION_DY[direction] < 0 && y != 0) {
+                    include_move(BLACK_PAWN, square, target);
+                }
+            }
+            for (int i = 0; i < RAY.length[square][direction]; ++i) {
+                include_move(WHITE_QUEEN, square, RAY.squares[square][direction][i]);
+                include_move(BLACK_QUEEN, square, RAY.squares[square][direction][i]);
+            }
+        }
+    }
+    return margin;
+}
+
+void checkers::bot::set_network(std::unique_ptr<Network> network)
+{
+    loadedNetwork = std::move(network);
+    // Oceny NNUE zapisane w tablicy pochodzą z poprzedniej sieci.
+    shared_eval_cache().clear();
+}
+
+const Network &checkers::bot::active_network()
+{
+    static const Network bootstrapNetwork = Network::bootstrap();
+    return loadedNetwork ? *loadedNetwork : bootstrapNetwork;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file Notation.cpp
+ * @author Maciej Wojno
+ * @brief Zawiera definicje funkcji zapisu tekstowego pól i ruchów.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "../include/Notation.hpp"
+
+using namespace checkers;
+
+std::string checkers::square_to_string(Square square)
+{
+    Coord coord = to_coord(square);
+    return std::string{static_cast<char>('a' + coord.x), static_cast<char>('1' + coord.y)};
+}
+
+std::optional<Square> checkers::square_from_string(const std::string &text)
+{
+    if (text.size() != 2) return std::nullopt;
+    Coord coord(text[0] - 'a', text[1] - '1');
+    if (!is_playable(coord)) return std::nullopt;
+    return to_square(coord);
+}
+
+std::string checkers::move_to_string(const GameState &gameState, Move move)
+{
+    char separator = gameState.must_capture() ? ':' : '-';
+    return square_to_string(move.from) + separator + square_to_string(move.to);
+}
+
+std::optional<Move> checkers::move_from_string(const std::string &text)
+{
+    if (text.size() != 5 || (text[2] != '-' && text[2] != ':')) return std::nullopt;
+    auto from = square_from_string(text.substr(0, 2));
+    auto to = square_from_string(text.substr(3, 2));
+    if (!from.has_value() || !to.has_value()) return std::nullopt;
+    return Move{from.value(), to.value()};
+}
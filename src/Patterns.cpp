@@ -0,0 +1,279 @@
+/**
+ * @file Patterns.cpp
+ * @author Bartosz Świrta
+ * @brief Zawiera definicję metod klasy PatternTables i generatora tablic wzorców.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "../include/Patterns.hpp"
+#include "../include/BotMove.hpp"
+#include "../include/EvalCache.hpp"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PATTERNS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace checkers;
+using namespace checkers::bot;
+
+namespace
+{
+    constexpr char PATTERN_MAGIC[4] = {'C', 'K', 'P', 'T'};
+    constexpr std::uint32_t PATTERN_VERSION = 1;
+    constexpr std::uint32_t PATTERN_DIMS[] = {PATTERN_VERSION, SQUARES, PATTERN_NEIGHBOURHOODS, PATTERN_ROWS,
+                                              PATTERN_ROW_CONFIGS};
+    constexpr std::size_t PATTERN_HEADER_BYTES = sizeof(PATTERN_MAGIC) + sizeof(PATTERN_DIMS);
+    constexpr std::size_t PATTERN_FILE_BYTES = PATTERN_HEADER_BYTES + sizeof(PatternData);
+
+    /// Kody sąsiada w indeksie sąsiedztwa.
+    enum NeighbourCode
+    {
+        EMPTY_CODE,
+        WHITE_CODE,
+        BLACK_CODE,
+        OFF_BOARD_CODE
+    };
+
+    /// Liczba pól planszy w rzędzie.
+    constexpr int ROW_SQUARES = Board8::BOARD_SIZE / 2;
+    /// Premia za piona białych w danym rzędzie (czarnych w rzędzie odbitym).
+    constexpr int ADVANCE_BONUS[PATTERN_ROWS] = {0, 0, 0, 1, 1, 2, 2, 0};
+    /// Indeksy w ostatnim rzędzie pól chroniących go przed wejściem pionów przeciwnika (c1 i e1, d8 i f8).
+    constexpr int GUARD_SQUARES[] = {1, 2};
+
+    /// Sąsiednie pole lub SQUARES, jeśli sąsiad jest poza planszą (tam leży kod OFF_BOARD_CODE).
+    constexpr std::array<std::array<std::uint8_t, DIRECTIONS>, SQUARES> make_neighbour_index()
+    {
+        std::array<std::array<std::uint8_t, DIRECTIONS>, SQUARES> table{};
+        for (int square = 0; square < SQUARES; ++square) {
+            for (int direction = 0; direction < DIRECTIONS; ++direction) {
+                Square neighbour = NEIGHBOUR[square][direction];
+                table[square][direction] = neighbour == NO_SQUARE ? SQUARES : neighbour;
+            }
+        }
+        return table;
+    }
+
+    constexpr auto NEIGHBOUR_INDEX = make_neighbour_index();
+
+    constexpr DirectionEnum opposite(int direction)
+    {
+        return static_cast<DirectionEnum>(DIRECTIONS - 1 - direction);
+    }
+
+    /**
+     * @brief Ocena bierki w podanym układzie sąsiedztwa, z perspektywy jej właściciela.
+     *
+     * @param y - rząd pola bierki
+     * @param piece - bierka na polu
+     * @param neighbours - kody sąsiadów w kolejności DirectionEnum
+     */
+    int neighbourhood_value(int y, PieceEnum piece, const int (&neighbours)[DIRECTIONS])
+    {
+        bool white = piece == WHITE_PAWN || piece == WHITE_QUEEN;
+        bool queen = piece == WHITE_QUEEN || piece == BLACK_QUEEN;
+        int own = white ? WHITE_CODE : BLACK_CODE;
+        int enemy = white ? BLACK_CODE : WHITE_CODE;
+        int forward[] = {white ? UP_RIGHT : DOWN_RIGHT, white ? UP_LEFT : DOWN_LEFT};
+        int backward[] = {opposite(forward[1]), opposite(forward[0])};
+        int rowsToPromotion = white ? PATTERN_ROWS - 1 - y : y;
+
+        int value = queen ? basicHeuristicTable[1] : basicHeuristicTable[0];
+        for (int direction = 0; direction < DIRECTIONS; ++direction) {
+            if (neighbours[direction] == enemy && neighbours[opposite(direction)] == EMPTY_CODE) {
+                value -= PATTERN_HANGING;
+                break;
+            }
+        }
+        if (queen) {
+            int free = 0;
+            for (int code : neighbours) free += code == EMPTY_CODE;
+            return value + (free >= 2 ? 1 : 0);
+        }
+
+        int freeForward = (neighbours[forward[0]] == EMPTY_CODE) + (neighbours[forward[1]] == EMPTY_CODE);
+        if (freeForward == 0 && rowsToPromotion > 0) {
+            // Zablokowany pion: może ruszyć się tylko biciem.
+            value -= 1;
+        }
+        if ((neighbours[backward[0]] == own || neighbours[backward[0]] == OFF_BOARD_CODE)
+            && (neighbours[backward[1]] == own || neighbours[backward[1]] == OFF_BOARD_CODE)) {
+            // Nie da się go przeskoczyć od przodu.
+            value += 1;
+        }
+        if (rowsToPromotion == 1 && freeForward > 0) {
+            value += PATTERN_RUNAWAY;
+        }
+        return value;
+    }
+
+    /// Ocena pionów jednego gracza w rzędzie, z perspektywy tego gracza.
+    int row_value(int relativeRow, unsigned pawns)
+    {
+        int value = 0;
+        for (int i = 0; i < ROW_SQUARES; ++i) {
+            if (pawns & (1u << i)) value += ADVANCE_BONUS[relativeRow];
+        }
+        if (relativeRow == 0) {
+            int guards = 0;
+            for (int i : GUARD_SQUARES) guards += (pawns >> i) & 1u;
+            value += guards + (guards == 2 ? 1 : 0);
+        }
+        return value;
+    }
+
+    std::unique_ptr<PatternTables> loadedTables;
+} // namespace
+
+PatternTables::~PatternTables()
+{
+#ifdef PATTERNS_MMAP
+    if (mapped) munmap(const_cast<char *>(image), PATTERN_FILE_BYTES);
+#endif
+}
+
+bool PatternTables::attach(const char *fileImage)
+{
+    std::uint32_t dims[std::size(PATTERN_DIMS)];
+    if (std::memcmp(fileImage, PATTERN_MAGIC, sizeof(PATTERN_MAGIC)) != 0) return false;
+    std::memcpy(dims, fileImage + sizeof(PATTERN_MAGIC), sizeof(dims));
+    if (std::memcmp(dims, PATTERN_DIMS, sizeof(dims)) != 0) return false;
+    image = fileImage;
+    data = reinterpret_cast<const PatternData *>(fileImage + PATTERN_HEADER_BYTES);
+    return true;
+}
+
+std::unique_ptr<PatternTables> PatternTables::try_map(const std::string &path)
+{
+    std::unique_ptr<PatternTables> tables(new PatternTables());
+#ifdef PATTERNS_MMAP
+    int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) return nullptr;
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || static_cast<std::size_t>(status.st_size) != PATTERN_FILE_BYTES) {
+        close(descriptor);
+        return nullptr;
+    }
+    void *mapping = mmap(nullptr, PATTERN_FILE_BYTES, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (mapping == MAP_FAILED) return nullptr;
+    tables->image = static_cast<const char *>(mapping);
+    tables->mapped = true;
+    if (!tables->attach(tables->image)) return nullptr;
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return nullptr;
+    tables->storage.resize(PATTERN_FILE_BYTES);
+    if (!file.read(tables->storage.data(), PATTERN_FILE_BYTES)) return nullptr;
+    if (file.peek() != std::ifstream::traits_type::eof()) return nullptr;
+    if (!tables->attach(tables->storage.data())) return nullptr;
+#endif
+    return tables;
+}
+
+std::unique_ptr<PatternTables> PatternTables::generate()
+{
+    std::unique_ptr<PatternTables> tables(new PatternTables());
+    tables->storage.resize(PATTERN_FILE_BYTES);
+    char *fileImage = tables->storage.data();
+    std::memcpy(fileImage, PATTERN_MAGIC, sizeof(PATTERN_MAGIC));
+    std::memcpy(fileImage + sizeof(PATTERN_MAGIC), PATTERN_DIMS, sizeof(PATTERN_DIMS));
+    PatternData &generated = *reinterpret_cast<PatternData *>(fileImage + PATTERN_HEADER_BYTES);
+
+    for (Square square = 0; square < SQUARES; ++square) {
+        int y = squares::square_y(square);
+        for (int index = 0; index < PATTERN_NEIGHBOURHOODS; ++index) {
+            auto piece = static_cast<PieceEnum>(index & 3);
+            int neighbours[DIRECTIONS];
+            for (int direction = 0; direction < DIRECTIONS; ++direction) {
+                neighbours[direction] = (index >> (2 * (direction + 1))) & 3;
+            }
+            bool white = piece == WHITE_PAWN || piece == WHITE_QUEEN;
+            int value = neighbourhood_value(y, piece, neighbours);
+            generated.neighbourhoods[square][index] = static_cast<std::int8_t>(white ? value : -value);
+        }
+    }
+    for (int y = 0; y < PATTERN_ROWS; ++y) {
+        for (unsigned index = 0; index < PATTERN_ROW_CONFIGS; ++index) {
+            unsigned whitePawns = index & ((1u << ROW_SQUARES) - 1);
+            // Rząd odbity dla czarnych: pole i rzędu y odpowiada polu ROW_SQUARES - 1 - i rzędu 7 - y.
+            unsigned blackPawns = 0;
+            for (int i = 0; i < ROW_SQUARES; ++i) {
+                if (index & (1u << (ROW_SQUARES + i))) blackPawns |= 1u << (ROW_SQUARES - 1 - i);
+            }
+            int value = row_value(y, whitePawns) - row_value(PATTERN_ROWS - 1 - y, blackPawns);
+            generated.rows[y][index] = static_cast<std::int8_t>(value);
+        }
+    }
+    tables->attach(fileImage);
+    return tables;
+}
+
+bool PatternTables::save(const std::string &path) const
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+    file.write(image, PATTERN_FILE_BYTES);
+    return static_cast<bool>(file);
+}
+
+int PatternTables::evaluate(const GameState &gameState) const
+{
+    std::uint32_t white = gameState.get_pieces(WHITE);
+    std::uint32_t black = gameState.get_pieces(BLACK);
+    std::uint32_t queens = gameState.get_queens();
+
+    // Kod każdego pola i pola poza planszą (ostatni element).
+    std::uint8_t codes[SQUARES + 1];
+    codes[SQUARES] = OFF_BOARD_CODE;
+    for (Square square = 0; square < SQUARES; ++square) {
+        codes[square] = static_cast<std::uint8_t>(((white >> square) & 1u) | (((black >> square) & 1u) << 1));
+    }
+
+    int score = 0;
+    std::uint32_t occupied = white | black;
+    for (Square square = 0; occupied != 0; ++square, occupied >>= 1) {
+        if ((occupied & 1u) == 0) continue;
+        const auto &neighbours = NEIGHBOUR_INDEX[square];
+        int index = ((white >> square) & 1u) | (((queens >> square) & 1u) << 1);
+        for (int direction = 0; direction < DIRECTIONS; ++direction) {
+            index |= codes[neighbours[direction]] << (2 * (direction + 1));
+        }
+        score += data->neighbourhoods[square][index];
+    }
+
+    std::uint32_t whitePawns = white & ~queens;
+    std::uint32_t blackPawns = black & ~queens;
+    for (int y = 0; y < PATTERN_ROWS; ++y) {
+        unsigned shift = y * ROW_SQUARES;
+        unsigned index = ((whitePawns >> shift) & 0xFu) | (((blackPawns >> shift) & 0xFu) << ROW_SQUARES);
+        score += data->rows[y][index];
+    }
+    return score;
+}
+
+void checkers::bot::set_pattern_tables(std::unique_ptr<PatternTables> tables)
+{
+    loadedTables = std::move(tables);
+    // Oceny PATTERN zapisane w tablicy pochodzą z poprzednich tablic wzorców.
+    shared_eval_cache().clear();
+}
+
+const PatternTables &checkers::bot::active_pattern_tables()
+{
+    static const std::unique_ptr<PatternTables> generatedTables = PatternTables::generate();
+    return loadedTables ? *loadedTables : *generatedTables;
+}
@@ -0,0 +1,456 @@
+/**
+ * @file Replay.cpp
+ * @author Maciej Wojno
+ * @brief Zawiera definicję metod klas RecordReader i Replay oraz odtwarzania partii.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "../include/Replay.hpp"
+#include "../include/Notation.hpp"
+#include "../include/Trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using namespace checkers;
+
+namespace
+{
+    bool is_result(const std::string &token)
+    {
+        return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*"
+               || token == "2-0" || token == "0-2" || token == "1-1";
+    }
+
+    /// Wynik zapisany w partii, nullopt jeśli nie jest znany.
+    std::optional<GameProgressEnum> result_progress(const std::string &result)
+    {
+        if (result == "1-0" || result == "2-0" || result == "white_won") return WHITE_WON;
+        if (result == "0-1" || result == "0-2" || result == "black_won") return BLACK_WON;
+        if (result == "1/2-1/2" || result == "1-1" || result == "tie") return TIE;
+        if (result == "game_interrupted") return PLAYING;
+        return std::nullopt;
+    }
+
+    /// Pole o numerze 1-32 z PDN: numery biegną rzędami od rzędu 8, w rzędzie od lewej.
+    std::optional<Square> square_from_number(const std::string &text)
+    {
+        if (text.empty() || text.size() > 2 || !std::all_of(text.begin(), text.end(), ::isdigit)) return std::nullopt;
+        int number = std::stoi(text);
+        if (number < 1 || number > SQUARES) return std::nullopt;
+        return static_cast<Square>((7 - (number - 1) / 4) * 4 + (number - 1) % 4);
+    }
+
+    std::optional<std::vector<Square>> parse_squares(const std::string &text)
+    {
+        std::vector<Square> squares;
+        std::size_t begin = 0;
+        while (begin <= text.size()) {
+            std::size_t end = text.find_first_of("-x:", begin);
+            if (end == std::string::npos) end = text.size();
+            std::string field = text.substr(begin, end - begin);
+            auto square = square_from_number(field);
+            if (!square.has_value()) square = square_from_string(field);
+            if (!square.has_value()) return std::nullopt;
+            squares.push_back(square.value());
+            begin = end + 1;
+        }
+        if (squares.size() < 2) return std::nullopt;
+        return squares;
+    }
+
+    /// Zamienia pozycję PDN (np. "W:W21,22,K30:B1,2") na zapis pozycji programu.
+    std::optional<GameState> position_from_pdn(const std::string &text)
+    {
+        std::string rows(SQUARES, '.');
+        std::size_t begin = 2;
+        while (begin < text.size()) {
+            std::size_t end = text.find(':', begin);
+            if (end == std::string::npos) end = text.size();
+            std::string field = text.substr(begin, end - begin);
+            begin = end + 1;
+            if (field.empty() || (field[0] != 'W' && field[0] != 'B')) return std::nullopt;
+            char pawn = field[0] == 'W' ? 'w' : 'b';
+
+            std::size_t item = 1;
+            while (item < field.size()) {
+                std::size_t comma = field.find(',', item);
+                if (comma == std::string::npos) comma = field.size();
+                std::string entry = field.substr(item, comma - item);
+                item = comma + 1;
+                if (entry.empty()) continue;
+                char piece = pawn;
+                if (entry[0] == 'K') {
+                    piece = static_cast<char>(std::toupper(pawn));
+                    entry = entry.substr(1);
+                }
+                std::size_t dash = entry.find('-');
+                std::string first = entry.substr(0, dash);
+                std::string last = dash == std::string::npos ? first : entry.substr(dash + 1);
+                if (!square_from_number(first).has_value() || !square_from_number(last).has_value()) return std::nullopt;
+                for (int number = std::stoi(first); number <= std::stoi(last); ++number) {
+                    rows[number - 1] = piece;
+                }
+            }
+        }
+
+        std::string position;
+        for (int row = 0; row < 8; ++row) {
+            position += rows.substr(row * 4, 4) + (row < 7 ? "/" : "");
+        }
+        position += text[0] == 'W' ? " w -" : " b -";
+        return GameState::try_from_string(position);
+    }
+
+    bool turn_continues(const GameState &gameState, PlayerEnum player)
+    {
+        return gameState.get_game_progress() == PLAYING && gameState.get_current_player() == player;
+    }
+
+    /**
+     * @brief Zbiera stany po biciach z pominiętymi polami pośrednimi, np. "c3:g7" zamiast "c3:e5:g7".
+     * @param finishing - czy bicie musi kończyć turę na polu docelowym
+     * @param paths - różne stany, do których prowadzą pasujące ścieżki
+     */
+    void collect_capture_paths(const GameState &gameState, Square from, Square to, PlayerEnum player,
+                               bool finishing, std::vector<GameState> &paths)
+    {
+        if (!gameState.must_capture()) return;
+        for (auto move : gameState.legal_moves()) {
+            if (move.from != from) continue;
+            GameState next = gameState;
+            next.try_make_move(move);
+            bool chain = turn_continues(next, player);
+            if (move.to == to && (!chain || !finishing)) {
+                bool known = std::any_of(paths.begin(), paths.end(), [&](const GameState &other) {
+                    return other.to_string() == next.to_string();
+                });
+                if (!known) paths.push_back(next);
+            }
+            if (chain) collect_capture_paths(next, move.to, to, player, finishing, paths);
+        }
+    }
+
+    std::string trim(const std::string &text)
+    {
+        auto begin = text.find_first_not_of(" \t\r");
+        if (begin == std::string::npos) return "";
+        auto end = text.find_last_not_of(" \t\r");
+        return text.substr(begin, end - begin + 1);
+    }
+} // namespace
+
+RecordReader::RecordReader(std::istream &input_, std::string source_)
+    : input(input_), source(std::move(source_))
+{
+    while (read_line()) {
+        pending = trim(pending);
+        if (!pending.empty()) break;
+    }
+    log = pending.rfind("white_param", 0) == 0;
+}
+
+bool RecordReader::read_line()
+{
+    if (!std::getline(input, pending)) return false;
+    ++lineNumber;
+    return true;
+}
+
+std::optional<RecordedGame> RecordReader::next()
+{
+    return log ? next_log() : next_pdn();
+}
+
+std::optional<RecordedGame> RecordReader::next_log()
+{
+    if (pending.empty()) return std::nullopt;
+    RecordedGame game{source, lineNumber, "", {}, ""};
+    std::string lastPlayer;
+    do {
+        std::istringstream tokens(pending);
+        std::string first, token, last;
+        tokens >> first;
+        while (tokens >> token) last = token;
+        if ((first == "white" || first == "black") && last.find_first_of("-:") != std::string::npos) {
+            // Kolejne skoki łańcucha bić zapisywane są w osobnych liniach tego samego gracza.
+            std::size_t separator = last.find_first_of("-:");
+            if (first == lastPlayer && !game.moves.empty()) {
+                game.moves.back().first += last.substr(separator);
+            } else {
+                game.moves.emplace_back(last, lineNumber);
+            }
+            lastPlayer = first;
+        } else if (result_progress(first).has_value()) {
+            game.result = first;
+        }
+    } while (read_line());
+    pending.clear();
+    return game;
+}
+
+std::optional<RecordedGame> RecordReader::next_pdn()
+{
+    RecordedGame game{source, 0, "", {}, ""};
+    std::string tagResult;
+    bool started = false;
+    bool inMoves = false;
+    int comments = 0;
+    int variations = 0;
+
+    while (true) {
+        std::size_t begin = pending.find_first_not_of(" \t\r");
+        if (begin == std::string::npos) {
+            if (!read_line()) break;
+            continue;
+        }
+        pending.erase(0, begin);
+
+        if (comments > 0 || pending[0] == '{') {
+            std::size_t end = pending.find('}');
+            comments = end == std::string::npos ? 1 : 0;
+            pending = end == std::string::npos ? "" : pending.substr(end + 1);
+            continue;
+        }
+        if (variations > 0 || pending[0] == '(') {
+            std::size_t i = 0;
+            for (; i < pending.size(); ++i) {
+                if (pending[i] == '(') ++variations;
+                if (pending[i] == ')' && --variations == 0) break;
+            }
+            pending = i < pending.size() ? pending.substr(i + 1) : "";
+            continue;
+        }
+        if (pending[0] == ';' || pending[0] == '%') {
+            pending.clear();
+            continue;
+        }
+        if (pending[0] == '[') {
+            // Znaczniki po ruchach bez wyniku zaczynają następną partię.
+            if (inMoves) break;
+            if (!started) game.line = lineNumber;
+            started = true;
+            std::size_t end = pending.find(']');
+            std::string tag = pending.substr(1, end == std::string::npos ? std::string::npos : end - 1);
+            pending = end == std::string::npos ? "" : pending.substr(end + 1);
+            std::size_t quote = tag.find('"');
+            if (quote == std::string::npos) continue;
+            std::string name = trim(tag.substr(0, quote));
+            std::string value = tag.substr(quote + 1, tag.rfind('"') - quote - 1);
+            if (name == "FEN") game.position = value;
+            if (name == "Result") tagResult = value;
+            continue;
+        }
+
+        std::size_t end = pending.find_first_of(" \t\r{(;");
+        std::string token = pending.substr(0, end);
+        pending = end == std::string::npos ? "" : pending.substr(end);
+        if (!started) game.line = lineNumber;
+        started = true;
+        inMoves = true;
+
+        if (is_result(token)) {
+            game.result = token;
+            break;
+        }
+        // Numer ruchu ("12." lub "12...") może być sklejony z ruchem ("12.c3-d4").
+        std::size_t digits = token.find_first_not_of("0123456789");
+        if (digits != std::string::npos && digits > 0 && token[digits] == '.') {
+            token.erase(0, token.find_first_not_of('.', digits));
+        }
+        if (token.empty() || token[0] == '$') continue;
+        token.erase(token.find_last_not_of("!?+#*") + 1);
+        if (!token.empty()) game.moves.emplace_back(token, lineNumber);
+    }
+
+    if (!started) return std::nullopt;
+    if (game.result.empty() || game.result == "*") game.result = tagResult;
+    return game;
+}
+
+std::optional<std::string> checkers::replay_game(const RecordedGame &game, std::uint64_t &moves)
+{
+    std::optional<GameState> start;
+    if (game.position.empty()) {
+        start = GameState();
+        start.value().init();
+    } else if (game.position.size() > 1 && (game.position[0] == 'W' || game.position[0] == 'B')
+               && game.position[1] == ':') {
+        start = position_from_pdn(game.position);
+    } else {
+        start = GameState::try_from_string(game.position);
+    }
+    if (!start.has_value()) return "malformed position \"" + game.position + "\"";
+
+    GameState gameState = start.value();
+    for (const auto &[text, line] : game.moves) {
+        std::string where = "line " + std::to_string(line) + ": move " + text + ": ";
+        if (gameState.get_game_progress() != PLAYING) return where + "game is already over";
+        auto squares = parse_squares(text);
+        if (!squares.has_value()) return where + "malformed move";
+
+        PlayerEnum player = gameState.get_current_player();
+        for (std::size_t i = 1; i < squares.value().size(); ++i) {
+            Square from = squares.value()[i - 1];
+            Square to = squares.value()[i];
+            bool last = i + 1 == squares.value().size();
+            if (!turn_continues(gameState, player)) return where + "illegal in " + gameState.to_string();
+
+            // Pojedynczy skok jest dosłownym odczytem zapisu, chyba że ostatnie pole kończy turę
+            // tylko po dłuższej ścieżce (królowa wracająca na to samo pole).
+            GameState direct = gameState;
+            bool directLegal = direct.try_make_move(Move{from, to});
+            if (directLegal && (!last || !turn_continues(direct, player))) {
+                gameState = direct;
+                continue;
+            }
+            std::vector<GameState> paths;
+            collect_capture_paths(gameState, from, to, player, last, paths);
+            if (paths.size() > 1) return where + "ambiguous capture in " + gameState.to_string();
+            if (paths.empty() && !directLegal) return where + "illegal in " + gameState.to_string();
+            gameState = paths.empty() ? direct : paths.front();
+        }
+        if (turn_continues(gameState, player)) {
+            return where + "capture sequence is incomplete";
+        }
+        ++moves;
+    }
+
+    auto expected = result_progress(game.result);
+    if (expected.has_value()) {
+        // Partia PDN może zakończyć się wcześniej poddaniem lub zgodą na remis, log rozgrywki nie.
+        bool recordedEarly = gameState.get_game_progress() == PLAYING && is_result(game.result);
+        if (gameState.get_game_progress() != expected.value() && !recordedEarly) {
+            return "result " + game.result + " does not match the final position " + gameState.to_string();
+        }
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Konstruktor z podaną konfiguracją.
+ *
+ * @param config_ - struktura przechowująca dane konfiguracyjne.
+ */
+Replay::Replay(const Config &config_)
+    : config(config_)
+{
+}
+
+void Replay::push(std::vector<RecordedGame> batch)
+{
+    std::unique_lock<std::mutex> lock(queueMutex);
+    queueChanged.wait(lock, [this] { return queue.size() < REPLAY_QUEUE_BATCHES; });
+    queue.push_back(std::move(batch));
+    queueChanged.notify_all();
+}
+
+std::optional<std::vector<RecordedGame>> Replay::pop()
+{
+    std::unique_lock<std::mutex> lock(queueMutex);
+    queueChanged.wait(lock, [this] { return !queue.empty() || activeReaders == 0; });
+    if (queue.empty()) return std::nullopt;
+    std::vector<RecordedGame> batch = std::move(queue.front());
+    queue.pop_front();
+    queueChanged.notify_all();
+    return batch;
+}
+
+void Replay::reader_done()
+{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    --activeReaders;
+    queueChanged.notify_all();
+}
+
+/**
+ * @brief Sprawdza partie z plików config.replayPaths.
+ * @details Błędy wypisywane są na bieżąco, po jednym na partię, a na koniec podsumowanie
+ *          z liczbą partii i ruchów na sekundę.
+ *
+ * @return Czy wszystkie pliki dało się odczytać i wszystkie partie są poprawne.
+ */
+bool Replay::run()
+{
+    const std::vector<std::string> &paths = config.replayPaths;
+    int threadCount = config.threads > 0
+            ? config.threads
+            : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    int readerCount = std::min(threadCount, static_cast<int>(paths.size()));
+    activeReaders = readerCount;
+
+    std::mutex outputMutex;
+    std::atomic<std::size_t> nextFile{0};
+    std::atomic<std::uint64_t> games{0};
+    std::atomic<std::uint64_t> moves{0};
+    std::atomic<std::uint64_t> errors{0};
+    std::atomic<bool> unreadable{false};
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < readerCount; ++i) {
+        threads.emplace_back([&]() {
+            trace::set_thread_name("replay_reader");
+            for (std::size_t index = nextFile++; index < paths.size(); index = nextFile++) {
+                std::ifstream file(paths[index]);
+                if (!file) {
+                    std::lock_guard<std::mutex> lock(outputMutex);
+                    std::cerr << "Cannot open " << paths[index] << std::endl;
+                    unreadable = true;
+                    continue;
+                }
+                RecordReader reader(file, paths[index]);
+                std::vector<RecordedGame> batch;
+                for (auto game = reader.next(); game.has_value(); game = reader.next()) {
+                    batch.push_back(std::move(game.value()));
+                    if (batch.size() == REPLAY_BATCH_SIZE) {
+                        push(std::move(batch));
+                        batch.clear();
+                    }
+                }
+                if (!batch.empty()) push(std::move(batch));
+            }
+            reader_done();
+        });
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        threads.emplace_back([&]() {
+            trace::set_thread_name("replay");
+            std::uint64_t localGames = 0, localMoves = 0;
+            for (auto batch = pop(); batch.has_value(); batch = pop()) {
+                trace::Span span("replay_batch", static_cast<std::int64_t>(batch.value().size()));
+                for (const RecordedGame &game : batch.value()) {
+                    ++localGames;
+                    auto error = replay_game(game, localMoves);
+                    if (error.has_value()) {
+                        ++errors;
+                        std::lock_guard<std::mutex> lock(outputMutex);
+                        std::cout << game.source << ":" << game.line << ": " << error.value() << std::endl;
+                    }
+                }
+            }
+            games += localGames;
+            moves += localMoves;
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "games " << games << " moves " << moves << " errors " << errors
+              << " time " << seconds * 1000.0 << " ms"
+              << " games/s " << static_cast<std::uint64_t>(games / std::max(seconds, 1e-9))
+              << " moves/s " << static_cast<std::uint64_t>(moves / std::max(seconds, 1e-9)) << std::endl;
+    return !unreadable && errors == 0;
+}
@@ -0,0 +1,442 @@
+/**
+ * @file Search.cpp
+ * @author Bartosz Świrta
+ * @brief Zawiera definicję metod klasy Search.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "../include/Search.hpp"
+#include "../include/BotMove.hpp"
+#include "../include/Endgame.hpp"
+#include "../include/Patterns.hpp"
+#include "../include/Trace.hpp"
+
+#include <algorithm>
+#include <climits>
+
+using namespace checkers;
+using namespace checkers::bot;
+
+Search::Search(HeuristicEnum heuristicType_, std::pmr::memory_resource *memory_)
+    : heuristicType(heuristicType_), memory(memory_)
+{
+}
+
+std::uint64_t Search::get_nodes() const
+{
+    return nodes;
+}
+
+EvalCacheStats Search::get_eval_cache_stats() const
+{
+    EvalCacheStats stats = evalStats;
+    if (evalSamples > 0) {
+        auto average = evalSampleTime / evalSamples;
+        stats.saved = std::chrono::duration_cast<std::chrono::microseconds>(average * stats.hits);
+    }
+    return stats;
+}
+
+void Search::set_eval_cache(EvalCache *cache)
+{
+    evalCache = cache;
+}
+
+void Search::set_iteration_callback(std::function<void(const SearchInfo &)> callback)
+{
+    onIteration = std::move(callback);
+}
+
+void Search::set_progress_callback(std::function<void(const SearchInfo &)> callback)
+{
+    onProgress = std::move(callback);
+}
+
+void Search::report_progress()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastProgress < PROGRESS_INTERVAL) return;
+    lastProgress = now;
+    onProgress(SearchInfo{currentDepth, nodes,
+                          std::chrono::duration_cast<std::chrono::microseconds>(now - startTime),
+                          to_root_moves(state->best), get_eval_cache_stats()});
+}
+
+std::vector<RootMove> Search::to_root_moves(const RootLines &lines)
+{
+    std::vector<RootMove> result;
+    result.reserve(lines.size());
+    for (const RootLine &line : lines) {
+        RootMove rootMove{line.move, line.score, line.depth, {line.move}};
+        rootMove.pv.insert(rootMove.pv.end(), line.pv.moves, line.pv.moves + line.pv.length);
+        result.push_back(std::move(rootMove));
+    }
+    return result;
+}
+
+bool Search::is_time_up() const
+{
+    if (stopSignal != nullptr && stopSignal->load(std::memory_order_relaxed)) return true;
+    return deadline.has_value() && std::chrono::steady_clock::now() >= deadline.value();
+}
+
+Search::RootState::RootState(std::pmr::memory_resource *memory)
+    : arena(SEARCH_ARENA_BYTES, memory), rootMoves(&arena), best(&arena), top(&arena), rest(&arena)
+{
+}
+
+std::vector<RootMove> Search::run(const GameState &gameState, const SearchLimits &limits)
+{
+    start(gameState, limits);
+    advance(std::nullopt);
+    std::vector<RootMove> result = to_root_moves(state->best);
+    accumulators = nullptr;
+    state.reset();
+    return result;
+}
+
+void Search::start(const GameState &gameState, const SearchLimits &limits)
+{
+    nodes = 0;
+    evalStats = EvalCacheStats();
+    evalSampleTime = std::chrono::steady_clock::duration::zero();
+    evalSamples = 0;
+    nodeLimit = limits.nodes;
+    startTime = std::chrono::steady_clock::now();
+    lastProgress = startTime;
+    deadline = std::nullopt;
+    if (limits.time.has_value()) {
+        deadline = startTime + limits.time.value();
+    }
+    stopSignal = limits.stop;
+    features = limits.features;
+    pathFingerprints[0] = gameState.get_fingerprint();
+    canStop = false;
+    stopped = false;
+    currentDepth = 1;
+    network = nullptr;
+
+    // Poprzedni obszar (wraz z akumulatorami) zwalniany jest przed utworzeniem nowego.
+    accumulators = nullptr;
+    state.reset();
+    state.emplace(memory);
+    RootState &s = state.value();
+    s.root = gameState;
+
+    // Wszystkie listy mają stałą pojemność, więc po rezerwacji iteracje nie alokują pamięci.
+    MoveList legalMoves = gameState.legal_moves();
+    std::size_t count = legalMoves.size();
+    for (RootLines *lines : {&s.rootMoves, &s.best, &s.rest}) {
+        lines->reserve(count);
+    }
+    // Nowy ruch trafia do top przed usunięciem z niej ruchu spoza K najlepszych.
+    s.top.reserve(count + 1);
+    for (auto move : legalMoves) {
+        s.rootMoves.push_back(RootLine{move, 0, 0, PrincipalVariation()});
+    }
+    s.finished = legalMoves.empty();
+    if (s.finished) return;
+
+    if (heuristicType == NNUE) {
+        network = &active_network();
+        std::pmr::polymorphic_allocator<Accumulator> allocator(&s.arena);
+        accumulators = allocator.allocate(MAX_PLY + 1);
+        network->refresh(gameState, accumulators[0]);
+    }
+
+    s.white = gameState.get_current_player() == WHITE;
+    s.multiPv = std::clamp(limits.multiPv, 1, static_cast<int>(count));
+    s.maxDepth = std::clamp(limits.depth, 1, MAX_PLY);
+}
+
+bool Search::step(std::chrono::steady_clock::duration slice)
+{
+    return advance(std::chrono::steady_clock::now() + slice);
+}
+
+void Search::stop()
+{
+    if (state.has_value()) state->finished = true;
+}
+
+bool Search::is_finished() const
+{
+    return !state.has_value() || state->finished;
+}
+
+std::vector<RootMove> Search::get_best() const
+{
+    if (!state.has_value()) return {};
+    return to_root_moves(state->best.empty() ? state->top : state->best);
+}
+
+SearchInfo Search::get_info() const
+{
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+    return SearchInfo{currentDepth, nodes, elapsed, get_best(), get_eval_cache_stats()};
+}
+
+bool Search::advance(std::optional<std::chrono::steady_clock::time_point> until)
+{
+    if (is_finished()) return true;
+    RootState &s = state.value();
+    std::optional<trace::Span> iterationSpan;
+    do {
+        if (!iterationSpan.has_value()) iterationSpan.emplace("iteration", s.depth);
+        if (s.next == 0) {
+            currentDepth = s.depth;
+            s.top.clear();
+            s.rest.clear();
+        }
+        search_root_move();
+        // Przerwana iteracja nie ma dokładnych ocen, wynikiem pozostaje poprzednia.
+        if (stopped) {
+            s.finished = true;
+            break;
+        }
+        if (++s.next == s.rootMoves.size()) {
+            complete_iteration();
+            iterationSpan.reset();
+        }
+    } while (!s.finished && (!until.has_value() || std::chrono::steady_clock::now() < until.value()));
+    return s.finished;
+}
+
+void Search::search_root_move()
+{
+    RootState &s = state.value();
+    bool white = s.white;
+    auto better = [white](int a, int b) { return white ? a > b : a < b; };
+    RootLine &rootMove = s.rootMoves[s.next];
+
+    // Ruchy gorsze od K-tego najlepszego nie potrzebują dokładnej oceny.
+    bool full = static_cast<int>(s.top.size()) < s.multiPv;
+    int threshold = full ? (white ? -SCORE_INFINITY : SCORE_INFINITY) : s.top.back().score;
+
+    trace::Span rootMoveSpan("root_move");
+    GameState localState = s.root;
+    localState.try_make_move(rootMove.move);
+    if (network) network->update(accumulators[0], accumulators[1], s.root, localState);
+    PrincipalVariation pv;
+    // Okno z perspektywy białych, negamax ocenia z perspektywy gracza wykonującego ruch po ruchu korzenia.
+    int alpha = white ? threshold : -SCORE_INFINITY;
+    int beta = white ? SCORE_INFINITY : threshold;
+    int score = localState.get_current_player() == WHITE
+            ? negamax(localState, s.depth - 1, 1, alpha, beta, pv)
+            : -negamax(localState, s.depth - 1, 1, -beta, -alpha, pv);
+    if (stopped) return;
+
+    if (full || better(score, threshold)) {
+        auto position = std::find_if(s.top.begin(), s.top.end(),
+                                     [&](const RootLine &other) { return better(score, other.score); });
+        s.top.insert(position, RootLine{rootMove.move, score, s.depth, pv});
+        if (static_cast<int>(s.top.size()) > s.multiPv) {
+            s.rest.push_back(s.top.back());
+            s.top.pop_back();
+        }
+    } else {
+        s.rest.push_back(rootMove);
+    }
+}
+
+void Search::complete_iteration()
+{
+    RootState &s = state.value();
+    // Kolejna iteracja zaczyna od najlepszych ruchów, pozostałe zachowują dotychczasową kolejność.
+    s.best.assign(s.top.begin(), s.top.end());
+    s.rootMoves.assign(s.top.begin(), s.top.end());
+    s.rootMoves.insert(s.rootMoves.end(), s.rest.begin(), s.rest.end());
+    canStop = true;
+
+    if (onIteration) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - startTime);
+        onIteration(SearchInfo{s.depth, nodes, elapsed, to_root_moves(s.best), get_eval_cache_stats()});
+    }
+    s.next = 0;
+    s.finished = s.depth == s.maxDepth || is_time_up();
+    if (!s.finished) ++s.depth;
+}
+
+int Search::futility_margin(int depth) const
+{
+    // Największa zmiana oceny po jednym cichym ruchu bez przemiany: przesunięcie piona o rząd
+    // (A_BASIC), wejście na pole przy krawędzi lub bliskie przemiany (BOARD_AWARE i sieć startowa NNUE)
+    // albo oszacowanie z wag wczytanej sieci NNUE.
+    int positional = 0;
+    switch (heuristicType) {
+        case BASIC:
+            positional = 0;
+            break;
+        case A_BASIC:
+            positional = 1;
+            break;
+        case BOARD_AWARE:
+            positional = boardAwarePositionalMax;
+            break;
+        case NNUE:
+            positional = (network ? *network : active_network()).positional_margin();
+            break;
+        case PATTERN:
+            positional = PATTERN_POSITIONAL_MAX;
+            break;
+    }
+    return positional + (depth - 1) * basicHeuristicTable[0];
+}
+
+int Search::evaluate(const GameState &gameState, int ply)
+{
+    if (evalCache == nullptr || gameState.get_game_progress() != PLAYING) {
+        return compute_evaluation(gameState, ply);
+    }
+    std::uint64_t hash = gameState.get_hash();
+    ++evalStats.probes;
+    if (auto cached = evalCache->probe(hash, heuristicType)) {
+        ++evalStats.hits;
+        return cached.value();
+    }
+    int score;
+    // Co EVAL_TIMING_INTERVAL-ta ocena jest mierzona, żeby oszacować czas zaoszczędzony przez trafienia.
+    if ((evalStats.probes - evalStats.hits) % EVAL_TIMING_INTERVAL == 1) {
+        auto begin = std::chrono::steady_clock::now();
+        score = compute_evaluation(gameState, ply);
+        evalSampleTime += std::chrono::steady_clock::now() - begin;
+        ++evalSamples;
+    } else {
+        score = compute_evaluation(gameState, ply);
+    }
+    evalCache->store(hash, heuristicType, score);
+    return score;
+}
+
+int Search::compute_evaluation(const GameState &gameState, int ply) const
+{
+    if (network && gameState.get_game_progress() == PLAYING) {
+        return network->evaluate(accumulators[ply]);
+    }
+    return estimate_move(gameState, heuristicType);
+}
+
+bool Search::is_path_repetition(const GameState &gameState, int ply) const
+{
+    int first = std::max(0, ply - gameState.get_reversible_moves());
+    for (int i = ply - 2; i >= first; --i) {
+        if (pathFingerprints[i] == pathFingerprints[ply]) return true;
+    }
+    return false;
+}
+
+int Search::negamax(const GameState &gameState, int depth, int ply, int alpha, int beta, PrincipalVariation &pv)
+{
+    pv.length = 0;
+    ++nodes;
+    if (canStop && nodeLimit.has_value() && nodes >= nodeLimit.value()) {
+        stopped = true;
+    }
+    if (canStop && (nodes & 1023) == 0 && is_time_up()) {
+        stopped = true;
+    }
+    if (onProgress && (nodes & 1023) == 0) {
+        report_progress();
+    }
+    if (stopped) {
+        return 0;
+    }
+    pathFingerprints[ply] = gameState.get_fingerprint();
+    if (gameState.get_game_progress() == PLAYING && is_path_repetition(gameState, ply)) {
+        return 0;
+    }
+    PlayerEnum mover = gameState.get_current_player();
+    int sign = mover == WHITE ? 1 : -1;
+
+    // Rozpoznana końcówka: remis kończy przeszukiwanie, a wygrana wystarcza, jeśli przekracza okno.
+    std::optional<EndgameScore> known;
+    bool knownLower = false;
+    if (features.endgameKnowledge) {
+        known = recognize_endgame(gameState);
+        if (known.has_value()) {
+            known->score *= sign;
+            knownLower = (known->bound == ENDGAME_LOWER) == (mover == WHITE);
+            if (known->bound == ENDGAME_EXACT
+                || (knownLower && known->score >= beta)
+                || (!knownLower && known->score <= alpha)) {
+                return known->score;
+            }
+        }
+    }
+    if (!depth || gameState.get_game_progress() != PLAYING)
+    {
+        int eval = sign * evaluate(gameState, ply);
+        if (known.has_value()) {
+            eval = knownLower ? std::max(eval, known->score) : std::min(eval, known->score);
+        }
+        return eval;
+    }
+
+    bool quiet = !gameState.must_capture();
+    MoveList moves = gameState.legal_moves();
+
+    // Wymuszone pojedyncze bicie nie zużywa głębokości.
+    int childDepth = depth - 1;
+    if (features.captureExtensions && !quiet && moves.size() == 1 && ply + depth < MAX_PLY) {
+        childDepth = depth;
+    }
+
+    // Tuż przed liśćmi ciche ruchy nie poprawią wyniku, jeśli nie pomaga nawet zapas oceny.
+    bool futile = false;
+    if (features.futilityPruning && quiet && depth <= FUTILITY_MAX_DEPTH) {
+        futile = sign * evaluate(gameState, ply) + futility_margin(depth) <= alpha;
+    }
+
+    int score = 0;
+    PrincipalVariation childPv;
+    GameState localState = gameState;
+    for(int i = 0; i < moves.size(); ++i){
+        Move move = moves[i];
+        localState.try_make_move(move);
+        auto piece = gameState.get_field(to_coord(move.from));
+        bool promotion = piece != localState.get_field(to_coord(move.to));
+        bool tactical = !quiet || promotion || localState.get_game_progress() != PLAYING;
+
+        if(futile && !tactical){
+            localState = gameState;
+            continue;
+        }
+        if(network)
+            network->update(accumulators[ply], accumulators[ply + 1], gameState, localState);
+        // W trakcie łańcucha bić kolejny krok wykonuje ten sam gracz.
+        bool sameMover = localState.get_current_player() == mover;
+        if(features.lateMoveReductions && depth >= LMR_MIN_DEPTH && i >= LMR_FULL_MOVES
+           && !tactical && !localState.must_capture()){
+            score = child_score(localState, sameMover, childDepth - 1, ply + 1, alpha, beta, childPv);
+            if(score > alpha && !stopped)
+                score = child_score(localState, sameMover, childDepth, ply + 1, alpha, beta, childPv);
+        }
+        else
+            score = child_score(localState, sameMover, childDepth, ply + 1, alpha, beta, childPv);
+        localState = gameState;
+        if(stopped)
+            return 0;
+
+        if(score > alpha){
+            alpha = score;
+            pv.moves[0] = move;
+            std::copy(childPv.moves, childPv.moves + childPv.length, pv.moves + 1);
+            pv.length = childPv.length + 1;
+        }
+        //alpha-beta pruning
+        if(alpha >= beta)
+            return beta;
+    }
+    return alpha;
+}
+
+int Search::child_score(const GameState &child, bool sameMover, int depth, int ply, int alpha, int beta,
+                        PrincipalVariation &pv)
+{
+    return sameMover ? negamax(child, depth, ply, alpha, beta, pv) : -negamax(child, depth, ply, -beta, -alpha, pv);
+}
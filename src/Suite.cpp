@@ -0,0 +1,220 @@
+/**
+ * @file Suite.cpp
+ * @author Bartosz Świrta
+ * @brief Zawiera definicję metod klasy Suite.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "../include/Suite.hpp"
+#include "../include/Notation.hpp"
+#include "../include/Search.hpp"
+#include "../include/Trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using namespace checkers;
+
+namespace
+{
+    bool contains(const std::vector<Move> &moves, Move move)
+    {
+        return std::any_of(moves.begin(), moves.end(), [move](Move other) {
+            return other.from == move.from && other.to == move.to;
+        });
+    }
+
+    std::string trim(const std::string &text)
+    {
+        auto begin = text.find_first_not_of(" \t\r");
+        if (begin == std::string::npos) return "";
+        auto end = text.find_last_not_of(" \t\r");
+        return text.substr(begin, end - begin + 1);
+    }
+} // namespace
+
+/**
+ * @brief Konstruktor z podaną konfiguracją.
+ *
+ * @param config_ - struktura przechowująca dane konfiguracyjne.
+ */
+Suite::Suite(const Config &config_)
+    : config(config_)
+{
+}
+
+/**
+ * @brief Wczytuje pozycje testowe z pliku.
+ * @details Niepoprawna linia (zły zapis pozycji albo ruch, który nie jest możliwy w pozycji)
+ *          powoduje odrzucenie całego zestawu, żeby wyniki nie dotyczyły niepełnego zestawu.
+ *
+ * @param path - ścieżka do pliku zestawu
+ * @return std::optional<std::vector<SuitePosition>> - pozycje lub nullopt jeśli pliku nie da się odczytać
+ */
+std::optional<std::vector<SuitePosition>> Suite::try_load(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Cannot open suite " << path << std::endl;
+        return std::nullopt;
+    }
+
+    std::vector<SuitePosition> positions;
+    std::string line;
+    for (int lineNumber = 1; std::getline(file, line); ++lineNumber) {
+        line = trim(line);
+        if (line.empty() || line[0] == '#') continue;
+
+        std::vector<std::string> parts;
+        std::istringstream fields(line);
+        for (std::string part; std::getline(fields, part, ';');) {
+            parts.push_back(trim(part));
+        }
+        if (parts.size() < 2 || parts.size() > 3) {
+            std::cerr << path << ":" << lineNumber << ": expected position ; solutions [; name]" << std::endl;
+            return std::nullopt;
+        }
+
+        auto gameState = GameState::try_from_string(parts[0]);
+        if (!gameState.has_value()) {
+            std::cerr << path << ":" << lineNumber << ": malformed position" << std::endl;
+            return std::nullopt;
+        }
+
+        SuitePosition position{parts.size() == 3 ? parts[2] : std::to_string(lineNumber), gameState.value(), {}};
+        MoveList legal = gameState.value().legal_moves();
+        std::istringstream moves(parts[1]);
+        for (std::string text; moves >> text;) {
+            auto move = move_from_string(text);
+            if (!move.has_value() || !contains(std::vector<Move>(legal.begin(), legal.end()), move.value())) {
+                std::cerr << path << ":" << lineNumber << ": illegal solution " << text << std::endl;
+                return std::nullopt;
+            }
+            position.solutions.push_back(move.value());
+        }
+        if (position.solutions.empty()) {
+            std::cerr << path << ":" << lineNumber << ": no solution given" << std::endl;
+            return std::nullopt;
+        }
+        positions.push_back(std::move(position));
+    }
+    return positions;
+}
+
+/**
+ * @brief Rozwiązuje jedną pozycję.
+ * @details Czas i liczba węzłów do rozwiązania liczone są do początku ostatniej serii iteracji,
+ *          w których najlepszym ruchem było rozwiązanie.
+ *
+ * @param position - rozwiązywana pozycja
+ * @return SuiteResult - wynik rozwiązywania
+ */
+SuiteResult Suite::solve(const SuitePosition &position) const
+{
+    const GameState &gameState = position.gameState;
+    bool white = gameState.get_current_player() == WHITE;
+    HeuristicEnum heuristic = white ? config.whiteBotHeuristic : config.blackBotHeuristic;
+
+    bot::SearchLimits limits;
+    limits.depth = bot::MAX_PLY;
+    limits.features = white ? config.whiteSearchFeatures : config.blackSearchFeatures;
+    if (config.suiteNodes.has_value()) {
+        limits.nodes = static_cast<std::uint64_t>(config.suiteNodes.value());
+    } else {
+        limits.time = std::chrono::milliseconds(config.suiteTime);
+    }
+
+    SuiteResult result;
+    std::optional<bot::SearchInfo> solvedSince;
+    bot::Search search(heuristic);
+    search.set_iteration_callback([&](const bot::SearchInfo &info) {
+        if (!contains(position.solutions, info.lines.front().move)) {
+            solvedSince = std::nullopt;
+        } else if (!solvedSince.has_value()) {
+            solvedSince = bot::SearchInfo{info.depth, info.nodes, info.time, {}, info.evalCache};
+        }
+    });
+
+    std::vector<bot::RootMove> best = search.run(gameState, limits);
+    if (best.empty()) return result;
+
+    result.bestMove = best.front().move;
+    result.solved = contains(position.solutions, best.front().move) && solvedSince.has_value();
+    if (result.solved) {
+        result.depth = solvedSince.value().depth;
+        result.time = solvedSince.value().time;
+        result.nodes = solvedSince.value().nodes;
+    }
+    return result;
+}
+
+/**
+ * @brief Rozwiązuje wszystkie pozycje i wypisuje wyniki na standardowe wyjście.
+ * @details Wątki pobierają kolejne pozycje ze wspólnego licznika, a wyniki wypisywane są
+ *          po zakończeniu w kolejności z pliku.
+ *
+ * @return Czy udało się wczytać zestaw.
+ */
+bool Suite::run()
+{
+    auto positions = try_load(config.suitePath.value());
+    if (!positions.has_value()) return false;
+
+    int threadCount = config.threads > 0
+            ? config.threads
+            : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    threadCount = std::min(threadCount, std::max(1, static_cast<int>(positions.value().size())));
+
+    std::vector<SuiteResult> results(positions.value().size());
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threadCount; ++i) {
+        workers.emplace_back([&]() {
+            trace::set_thread_name("suite");
+            for (size_t index = next++; index < results.size(); index = next++) {
+                trace::Span span("suite_position", static_cast<std::int64_t>(index));
+                results[index] = solve(positions.value()[index]);
+            }
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    int solved = 0;
+    std::chrono::microseconds totalTime{0};
+    std::uint64_t totalNodes = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const SuitePosition &position = positions.value()[i];
+        const SuiteResult &result = results[i];
+        std::cout << std::left << std::setw(16) << position.name
+                  << (result.solved ? " solved  " : " unsolved");
+        if (result.bestMove.has_value()) {
+            std::cout << " best " << move_to_string(position.gameState, result.bestMove.value());
+        } else {
+            std::cout << " best none";
+        }
+        if (result.solved) {
+            ++solved;
+            totalTime += result.time;
+            totalNodes += result.nodes;
+            std::cout << " depth " << result.depth
+                      << " time " << result.time.count() / 1000.0 << " ms"
+                      << " nodes " << result.nodes;
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "solved " << solved << "/" << results.size()
+              << " time " << totalTime.count() / 1000.0 << " ms"
+              << " nodes " << totalNodes << std::endl;
+    return true;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file Trace.cpp
+ * @author Maciej Wojno
+ * @brief Zawiera definicję zapisu przebiegu programu w formacie Chrome trace event.
+ * @version 1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "../include/Trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace checkers;
+
+namespace
+{
+    /// Zakończony odcinek, czasy w mikrosekundach od startu zbierania.
+    struct TraceEvent
+    {
+        const char *name;
+        std::int64_t arg;
+        std::int64_t start;
+        std::int64_t duration;
+    };
+
+    /// Bufor pierścieniowy zdarzeń jednego wątku.
+    struct ThreadBuffer
+    {
+        explicit ThreadBuffer(int id_) : id(id_), events(new TraceEvent[trace::TRACE_BUFFER_EVENTS]) {}
+
+        int id;
+        std::string name;
+        std::unique_ptr<TraceEvent[]> events;
+        /// Liczba zapisanych zdarzeń, publikowana po zapisie zdarzenia.
+        std::atomic<std::uint64_t> count{0};
+    };
+
+    std::atomic<bool> collecting{false};
+    std::string outputPath;
+    std::chrono::steady_clock::time_point origin;
+
+    /// Bufory wszystkich wątków. Żyją do końca programu, więc przeżywają wątki, które do nich piszą.
+    std::mutex buffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    thread_local ThreadBuffer *threadBuffer = nullptr;
+
+    ThreadBuffer &current_buffer()
+    {
+        if (!threadBuffer) {
+            std::lock_guard<std::mutex> lock(buffersMutex);
+            buffers.push_back(std::make_unique<ThreadBuffer>(static_cast<int>(buffers.size()) + 1));
+            threadBuffer = buffers.back().get();
+        }
+        return *threadBuffer;
+    }
+
+    std::int64_t microseconds(std::chrono::steady_clock::duration duration)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    }
+} // namespace
+
+void trace::start(const std::string &path)
+{
+    outputPath = path;
+    origin = std::chrono::steady_clock::now();
+    collecting.store(true, std::memory_order_release);
+}
+
+bool trace::finish()
+{
+    if (!collecting.exchange(false)) return true;
+
+    std::ofstream file(outputPath);
+    if (!file) return false;
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (auto &buffer : buffers) {
+        std::string name = buffer->name.empty() ? "thread " + std::to_string(buffer->id) : buffer->name;
+        file << (first ? "" : ",") << "\n{\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id
+             << ",\"name\":\"thread_name\",\"args\":{\"name\":\"" << name << "\"}}";
+        first = false;
+
+        // Z pełnego bufora zostaje ostatnie TRACE_BUFFER_EVENTS zdarzeń.
+        std::uint64_t count = buffer->count.load(std::memory_order_acquire);
+        std::uint64_t begin = count - std::min<std::uint64_t>(count, TRACE_BUFFER_EVENTS);
+        for (std::uint64_t i = begin; i < count; ++i) {
+            const TraceEvent &event = buffer->events[i % TRACE_BUFFER_EVENTS];
+            file << ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->id << ",\"name\":\"" << event.name
+                 << "\",\"ts\":" << event.start << ",\"dur\":" << event.duration;
+            if (event.arg != NO_ARG) {
+                file << ",\"args\":{\"value\":" << event.arg << "}";
+            }
+            file << "}";
+        }
+    }
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
+
+bool trace::enabled()
+{
+    return collecting.load(std::memory_order_relaxed);
+}
+
+void trace::set_thread_name(const char *name)
+{
+    if (!enabled()) return;
+    ThreadBuffer &buffer = current_buffer();
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    buffer.name = name;
+}
+
+trace::Span::Span(const char *name_, std::int64_t arg_)
+    : name(enabled() ? name_ : nullptr), arg(arg_)
+{
+    if (name) begin = std::chrono::steady_clock::now();
+}
+
+trace::Span::~Span()
+{
+    if (!name || !enabled()) return;
+    auto end = std::chrono::steady_clock::now();
+    ThreadBuffer &buffer = current_buffer();
+    std::uint64_t index = buffer.count.load(std::memory_order_relaxed);
+    buffer.events[index % TRACE_BUFFER_EVENTS] =
+            TraceEvent{name, arg, microseconds(begin - origin), microseconds(end - begin)};
+    buffer.count.store(index + 1, std::memory_order_release);
+}
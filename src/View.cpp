@@ -9,9 +9,12 @@
  * 
  */
 
+#include <algorithm>
+#include <cfloat>
 #include <optional>
 
 #include "../include/View.hpp"
+#include "../include/Trace.hpp"
 
 using namespace checkers;
 
@@ -21,11 +24,13 @@ using namespace checkers;
  * 
  * @param config - konifuracja używana przy tworzeniu widoku.
  * @param messageQueues_ - uchwyt do kolejki komunikatów.
+ * @param showStats_ - czy pokazywać panel ze statystykami botów.
  */
-View::View(std::shared_ptr<MessageQueues> messageQueues_)
+View::View(std::shared_ptr<MessageQueues> messageQueues_, bool showStats_)
     : Application(400, 400, "Checkers", false)
     , messageQueues(std::move(messageQueues_))
     , lastState()
+    , showStats(showStats_)
 {
 //    set_window_size(400, 400);
 }
@@ -41,6 +46,8 @@ const int IMGUI_NO_MOVE = 1 << 2;
 const int IMGUI_NO_SCROLLBAR = 1 << 3;
 const int IMGUI_NO_SCROLL_MOUSE = 1 << 4;
 
+const int IMGUI_ALWAYS_AUTO_RESIZE = 1 << 6;
+
 const int IMGUI_WINDOW_FLAGS =
     IMGUI_NO_TITLE_BAR |
     IMGUI_NO_RESIZE |
@@ -48,6 +55,8 @@ const int IMGUI_WINDOW_FLAGS =
     IMGUI_NO_SCROLLBAR |
     IMGUI_NO_SCROLL_MOUSE;
 
+const int IMGUI_STATS_FLAGS = IMGUI_ALWAYS_AUTO_RESIZE;
+
 /**
  * @brief Funkcja aktualizacji interfejsu gracza.
  * @details Jest wykonywana w pętli, ponieważ jest to interfejs typu immidiate mode GUI
@@ -55,6 +64,7 @@ const int IMGUI_WINDOW_FLAGS =
  */
 void View::update()
 {
+    trace::Span span("view_update");
     ImGui::SetNextWindowSize(get_window_size());
     ImGui::SetNextWindowPos(get_window_pos());
     ImGui::Begin("window", nullptr, IMGUI_WINDOW_FLAGS);
@@ -67,6 +77,7 @@ void View::update()
         GameProgressEnum &progress = lastState.value().gameProgressEnum;
         BoardState &boardState = lastState.value().boardState;
         std::optional<Coord> &selected = lastState->selectedField;
+        std::uint32_t targets = selected ? lastState->legalMoves.get_targets(selected.value()) : 0;
 
         if (progress == PLAYING) {
 
@@ -79,7 +90,8 @@ void View::update()
                     ImGui::PushID("b");
 
                     bool is_selected = selected && selected.value().x == x && selected.value().y == y;
-                    if (board_button(boardState.fields[x][y], is_selected, (x + y) % 2 == 0))
+                    bool is_target = is_playable(Coord(x, y)) && (targets & square_mask(to_square(Coord(x, y))));
+                    if (board_button(boardState.fields[x][y], is_selected, is_target, (x + y) % 2 == 0))
                     {
                         send_player_input(PlayerInputMessage(SELECT, x, y));
                     }
@@ -115,6 +127,64 @@ void View::update()
     }
 
     ImGui::End();
+
+    if (showStats) {
+        stats_panel();
+    }
+}
+
+/**
+ * @brief Wyświetla panel ze statystykami botów.
+ * @details Panel jest osobnym oknem nad planszą, które można przesunąć lub zwinąć.
+ * 
+ */
+void View::stats_panel()
+{
+    auto stats = messageQueues->check_for_stats();
+    if (stats)
+    {
+        lastStats = stats;
+    }
+    if (!lastStats)
+    {
+        return;
+    }
+    const StatsMessage &current = lastStats.value();
+
+    ImGui::SetNextWindowBgAlpha(0.8f);
+    ImGui::SetNextWindowPos(ImVec2(10.0f, 10.0f), ImGuiCond_FirstUseEver);
+    ImGui::Begin("Engine", nullptr, IMGUI_STATS_FLAGS);
+
+    ImGui::Text("%s: %s", current.player == WHITE ? "White" : "Black", current.searching ? "thinking" : "done");
+    // Monte Carlo Tree Search (maxDepth == 0) raportuje tylko liczbę symulacji, bez głębokości i oceny.
+    bool alphaBeta = current.maxDepth > 0;
+    if (alphaBeta) {
+        ImGui::Text("Depth: %d/%d", current.depth, current.maxDepth);
+    }
+    ImGui::Text("%s: %llu", alphaBeta ? "Nodes" : "Iterations", static_cast<unsigned long long>(current.nodes));
+    unsigned long long nps = current.elapsedMs > 0 ? current.nodes * 1000 / current.elapsedMs : 0;
+    ImGui::Text("NPS: %llu", nps);
+    ImGui::Text("Elapsed: %lld ms", static_cast<long long>(current.elapsedMs));
+    if (current.remainingMs >= 0) {
+        ImGui::Text("Remaining: %lld ms", static_cast<long long>(current.remainingMs));
+    }
+    if (alphaBeta) {
+        ImGui::Text("Eval cache: %.1f%% hits, %lld ms saved", current.evalHitRate,
+                    static_cast<long long>(current.evalSavedMs));
+        ImGui::Text("Score: %d", current.score);
+        ImGui::TextWrapped("PV: %s", current.pv);
+    }
+
+    int count = std::min(current.latencyCount, STATS_LATENCY_HISTORY);
+    if (count > 0) {
+        int offset = current.latencyCount > STATS_LATENCY_HISTORY ? current.latencyCount % STATS_LATENCY_HISTORY : 0;
+        int last = (current.latencyCount - 1) % STATS_LATENCY_HISTORY;
+        ImGui::Text("Last move: %.1f ms", current.latenciesMs[last]);
+        ImGui::PlotLines("##latency", current.latenciesMs, count, offset, "move latency", 0.0f, FLT_MAX,
+                         ImVec2(200.0f, 40.0f));
+    }
+
+    ImGui::End();
 }
 
 /**
@@ -136,13 +206,16 @@ ImVec2 View::get_button_size() {
  * @brief Wyświetla przycisk na planszy w podanym stanie.
  * 
  * @param state - aktualna plansza.
+ * @param is_target - czy pole jest docelowym polem ruchu zaznaczonej bierki.
  * @return true - gdy przycisk został poprawnie wyświetlony.
  * @return false - w przypadku błędu.
  */
-bool View::board_button(std::optional<PieceEnum> &pawn, bool is_selected, bool is_dark) const
+bool View::board_button(std::optional<PieceEnum> &pawn, bool is_selected, bool is_target, bool is_dark) const
 {
     if (is_selected) {
         ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.5f, 0.5f, 1.0f, 1.0f));
+    } else if (is_target) {
+        ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.4f, 0.7f, 0.4f, 1.0f));
     } else {
         if (is_dark) {
             ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.5f, 0.5f, 0.5f, 1.0f));
@@ -13,32 +13,104 @@
 
 #include "../include/View.hpp"
 #include "../include/Controller.hpp"
+#include "../include/Engine.hpp"
+#include "../include/Suite.hpp"
+#include "../include/Replay.hpp"
+#include "../include/Bench.hpp"
+#include "../include/Memory.hpp"
+#include "../include/Nnue.hpp"
+#include "../include/Patterns.hpp"
+#include "../include/Trace.hpp"
 
 using namespace checkers;
 
-int main(int argc, char *argv[])
+/**
+ * @brief Uruchamia wybrany konfiguracją tryb programu.
+ *
+ * @return int - kod wyjścia programu
+ */
+static int run(Config &config)
 {
-    std::optional<Config> config = Config::try_from_args(argc, argv);
-    if (!config.has_value())
-    {
-        std::cerr << "Config error!" << std::endl;
-        return 1;
+    if (config.nnueSavePath.has_value()) {
+        return bot::Network::bootstrap().save(config.nnueSavePath.value()) ? 0 : 1;
+    }
+    if (config.nnuePath.has_value()) {
+        auto network = bot::Network::try_load(config.nnuePath.value());
+        if (!network.has_value())
+        {
+            std::cerr << "NNUE weights error!" << std::endl;
+            return 1;
+        }
+        bot::set_network(std::make_unique<bot::Network>(network.value()));
+    }
+    if (config.patternsSavePath.has_value()) {
+        return bot::PatternTables::generate()->save(config.patternsSavePath.value()) ? 0 : 1;
+    }
+    if (config.patternsPath.has_value()) {
+        auto tables = bot::PatternTables::try_map(config.patternsPath.value());
+        if (tables == nullptr)
+        {
+            std::cerr << "Pattern tables error!" << std::endl;
+            return 1;
+        }
+        bot::set_pattern_tables(std::move(tables));
+    }
+
+    if (config.benchPath.has_value()) {
+        return Bench(config).run() ? 0 : 1;
+    }
+
+    if (!config.replayPaths.empty()) {
+        return Replay(config).run() ? 0 : 1;
+    }
+
+    if (config.suitePath.has_value()) {
+        return Suite(config).run() ? 0 : 1;
+    }
+
+    if (config.engineMode) {
+        Engine(config).run();
+        return 0;
     }
 
     std::shared_ptr<MessageQueues> message_queues = std::make_shared<MessageQueues>();
 
-    if (config.value().showGUI) {
-        auto controller = std::make_unique<Controller>(config.value(), message_queues);
+    if (config.showGUI) {
+        auto controller = std::make_unique<Controller>(config, message_queues);
 
         std::thread controller_thread([&controller]() {
+            trace::set_thread_name("controller");
             controller->run();
         });
-        View(message_queues).run();
+        trace::set_thread_name("view");
+        View(message_queues, config.showStats).run();
 
         controller_thread.join();
     } else {
-        Controller(config.value(), message_queues).run();
+        trace::set_thread_name("controller");
+        Controller(config, message_queues).run();
     }
 
     return 0;
 }
+
+int main(int argc, char *argv[])
+{
+    std::optional<Config> config = Config::try_from_args(argc, argv);
+    if (!config.has_value())
+    {
+        std::cerr << "Config error!" << std::endl;
+        return 1;
+    }
+
+    if (config.value().tracePath.has_value()) {
+        trace::start(config.value().tracePath.value());
+        trace::set_thread_name("main");
+    }
+    memory::set_counting(config.value().memoryStats);
+    int result = run(config.value());
+    if (!trace::finish()) {
+        std::cerr << "Trace error!" << std::endl;
+    }
+    return result;
+}